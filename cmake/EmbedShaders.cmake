@@ -0,0 +1,23 @@
+# Génère un en-tête C++ contenant tous les fichiers de shaders/ (builds Release).
+# Usage : cmake -DSHADER_DIR=<shaders> -DOUTPUT=<en-tête> -P EmbedShaders.cmake
+file(GLOB SHADER_FILES "${SHADER_DIR}/*.glsl")
+list(SORT SHADER_FILES)
+
+set(CONTENT "// Généré par cmake/EmbedShaders.cmake à partir de shaders/ : ne pas modifier\n")
+string(APPEND CONTENT "#ifndef EMBEDDED_SHADERS_H\n#define EMBEDDED_SHADERS_H\n\n")
+string(APPEND CONTENT "struct EmbeddedShader {\n    const char* name;\n    const char* source;\n};\n\n")
+string(APPEND CONTENT "static const EmbeddedShader EMBEDDED_SHADERS[] = {\n")
+foreach(SHADER_FILE ${SHADER_FILES})
+    get_filename_component(SHADER_NAME "${SHADER_FILE}" NAME)
+    file(READ "${SHADER_FILE}" SHADER_SOURCE)
+    string(APPEND CONTENT "    {\"${SHADER_NAME}\", R\"glsl(${SHADER_SOURCE})glsl\"},\n")
+endforeach()
+string(APPEND CONTENT "};\n\n#endif\n")
+
+# Réécrit seulement si le contenu change, pour ne pas tout recompiler
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" PREVIOUS)
+endif()
+if(NOT "${PREVIOUS}" STREQUAL "${CONTENT}")
+    file(WRITE "${OUTPUT}" "${CONTENT}")
+endif()
@@ -0,0 +1,88 @@
+#ifndef AUTOPLAYER_H
+#define AUTOPLAYER_H
+
+#include "Simulation.h"
+#include "TranspositionTable.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class NeuralEvaluator;
+
+// Joueur automatique : énumère les placements (rotation, colonne) de la pièce
+// active et garde celui dont le plateau résultant a la meilleure évaluation.
+class Autoplayer {
+public:
+    enum Feature {
+        AGGREGATE_HEIGHT = 0,
+        COMPLETE_LINES = 1,
+        HOLES = 2,
+        BUMPINESS = 3,
+        MAX_HEIGHT = 4,
+        FEATURE_COUNT = 5
+    };
+
+    using Weights = std::array<float, FEATURE_COUNT>;
+
+    struct Placement {
+        int rotation = 0;
+        int x = 0;
+        float score = 0.0f;
+        bool valid = false;
+    };
+
+    static Weights defaultWeights();
+
+    explicit Autoplayer(const Weights& weights = defaultWeights(), int depth = 1);
+
+    // Profondeur 1 : seule la pièce active ; 2 : on tient compte de la
+    // première pièce de la file
+    void setDepth(int depth) { this->depth = depth; }
+    int getDepth() const { return depth; }
+    const Weights& getWeights() const { return weights; }
+
+    // Table partagée entre les recherches et les threads ; les clés sont salées
+    // par les poids et l'empreinte du réseau, si bien que des joueurs différents
+    // peuvent s'en servir ensemble. Le propriétaire de la table appelle
+    // newSearch : par recherche pour un seul joueur, plus rarement si plusieurs
+    // parties la remplissent en parallèle. nullptr pour la désactiver
+    void setTranspositionTable(TranspositionTable* table) { transpositionTable = table; }
+
+    // Remplace le terme de plateau de l'heuristique aux feuilles par le réseau
+    // (évalué par lots) ; le terme des lignes effacées reste pondéré par les poids
+    void setNeuralEvaluator(const NeuralEvaluator* evaluator) { neuralEvaluator = evaluator; }
+
+    Placement findBestPlacement(const Simulation& simulation) const;
+    void applyPlacement(Simulation& simulation, const Placement& placement) const;
+    int playGame(Simulation& simulation, int maxPieces) const;
+
+    float evaluate(const uint8_t* cells, int width, int height, int linesCleared) const;
+    static void computeFeatures(const uint8_t* cells, int width, int height, int linesCleared,
+                                float features[FEATURE_COUNT]);
+
+    // Cases occupées par la pièce une fois tombée depuis le haut dans la colonne x.
+    // Retourne false si elle ne peut pas y être posée entièrement dans le puits.
+    static bool landingBlocks(const uint8_t* cells, int width, int height, PieceType type,
+                              int rotation, int x, glm::ivec2 blocks[4]);
+
+    // Pose la pièce dans la colonne x en la faisant tomber depuis le haut.
+    // Retourne le nombre de lignes effacées, ou -1 si le placement est impossible.
+    static int dropPiece(uint8_t* cells, int width, int height, PieceType type,
+                         int rotation, int x);
+
+private:
+    Weights weights;
+    int depth;
+    TranspositionTable* transpositionTable;
+    const NeuralEvaluator* neuralEvaluator;
+    // Sel des clés de table dû aux poids ; celui du réseau est relu à chaque
+    // recherche, l'évaluateur pouvant être rechargé entre-temps
+    uint64_t weightsSalt;
+
+    float searchBest(const uint8_t* cells, int width, int height, const PieceType* pieces,
+                     int pieceCount, std::vector<uint8_t>* scratch, Placement* best) const;
+    float searchLeafBatched(const uint8_t* cells, int width, int height, PieceType piece,
+                            std::vector<uint8_t>& batch, Placement* best) const;
+};
+
+#endif
\ No newline at end of file
@@ -1,22 +1,21 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include "Autoplayer.h"
 #include "Cube.h"
-#include "Piece.h"
+#include "DynamicResolution.h"
+#include "GpuTimer.h"
+#include "PerfOverlay.h"
+#include "Simulation.h"
 #include "TextRenderer.h"
 #include <vector>
-#include <random>
 #include <glm/glm.hpp>
 
-enum class GameState {
-    WAITING_TO_START,
-    PLAYING,
-    GAME_OVER
-};
+class VoxelField;
 
 class Board {
 public:
-    Board();
+    Board(int width = FIELD_WIDTH, int height = FIELD_HEIGHT);
     ~Board();
     
     void render();
@@ -30,42 +29,90 @@ public:
 
     void dropCurrentPiece();
     
-    GameState getGameState() const { return gameState; }
-    int getScore() const { return score; }
-    int getLinesCleared() const { return linesCleared; }
+    // Placement conseillé affiché en fantôme (nullptr pour le masquer)
+    void setHint(const Autoplayer::Placement* placement);
+    void setAutoplay(bool enabled) { autoplay = enabled; }
+    
+    // Graphe des temps d'image et temps GPU par passe (requêtes actives seulement s'il est affiché)
+    void setPerfOverlay(bool visible);
+    // Pile rendue par lancer de rayons au lieu d'un cube par cellule (grands puits)
+    void setVoxelField(bool enabled);
+    bool isVoxelField() const { return voxelField != nullptr; }
+    bool isPerfOverlayVisible() const { return perfOverlayVisible; }
+    // Statistiques de la table du Ponderer, affichées sous les temps de l'overlay
+    void setTableStats(const TranspositionTable::Stats& stats);
+    // Scène rendue à une échelle ajustée au budget GPU, interface en natif
+    void setDynamicResolution(const DynamicResolution::Options& options);
+    const DynamicResolution* getDynamicResolution() const { return resolution; }
+    // Murs, pile, fantôme et pièce gardés sur le GPU
+    const ResidentCubes& getSceneCubes() const { return *sceneCubes; }
+    // Taille du framebuffer : perspective et interface suivent son format
+    void setViewportSize(int width, int height);
+    void setFrameTime(float milliseconds) { frameMs = milliseconds; }
+    
+    // Incrémentée à chaque changement visible (pièce, pile, score, état, fantôme)
+    unsigned getRevision() const { return revision; }
+    void invalidate() { revision++; }
+    
+    GameState getGameState() const { return simulation.getGameState(); }
+    int getScore() const { return simulation.getScore(); }
+    int getLinesCleared() const { return simulation.getLinesCleared(); }
+    const Simulation& getSimulation() const { return simulation; }
+    Simulation& getSimulation() { return simulation; }
+
+    int getFieldWidth() const { return fieldWidth; }
+    int getFieldHeight() const { return fieldHeight; }
 
-private:
     static const int FIELD_WIDTH = 10;
     static const int FIELD_HEIGHT = 20;
+    // Espace dans lequel l'interface est disposée, agrandi à la taille réelle
+    static const int LAYOUT_WIDTH = 1200;
+    static const int LAYOUT_HEIGHT = 900;
+
+private:
+    int fieldWidth;
+    int fieldHeight;
+    
+    // Plages de sceneCubes, dessinées dans cet ordre
+    enum SceneRange { WALL_RANGE, STACK_RANGE };
     
-    std::vector<std::vector<Cube*>> field;
-    std::vector<Cube*> walls;
-    std::vector<Cube*> floorTiles;
+    ResidentCubes* sceneCubes;
+    // Fantôme et pièce, réécrits à chaque image dans l'anneau de flux : le
+    // tampon résident n'est jamais modifié pendant que le GPU le lit
+    CubeInstances* pieceCubes;
+    // Cellules déjà envoyées dans la plage de la pile, et lignes non vides
+    std::vector<uint8_t> syncedCells;
+    std::vector<bool> filledRows;
+    std::vector<CubeInstance> rowInstances;
+    std::vector<CubeInstance> pieceInstances;
+    
+    Autoplayer::Placement hint;
+    bool hintVisible;
+    bool autoplay;
     
     TextRenderer* textRenderer;
+    GpuTimer* gpuTimer;
+    PerfOverlay* perfOverlay;
+    VoxelField* voxelField;
+    DynamicResolution* resolution;
+    bool perfOverlayVisible;
+    float frameMs;
+    unsigned revision;
     
-    Piece* currentPiece;
-    GameState gameState;
-    int score;
-    int linesCleared;
+    Simulation simulation;
     
+    int viewportWidth;
+    int viewportHeight;
+    float cameraDistance;
     glm::mat4 view;
     glm::mat4 projection;
     
-    std::mt19937 rng;
-    std::uniform_int_distribution<int> pieceDist;
-    
     void initializeWalls();
     void initializeFloor();
-    void clearField();
-    void spawnNewPiece();
-    bool isValidPosition(const std::vector<glm::vec2>& positions);
-    void lockCurrentPiece();
-    void checkAndClearLines();
-    bool isLineFull(int line);
-    void clearLine(int line);
-    void dropLinesAbove(int clearedLine);
+    void syncField();
+    void collectPieceInstances();
     void renderInstructions();
+    void renderGlStats();
 };
 
 #endif
\ No newline at end of file
@@ -1,44 +1,138 @@
 #ifndef CUBE_H
 #define CUBE_H
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <vector>
 
 class Cube {
 public:
+    static const int VERTEX_COUNT = 24;
+    static const int INDEX_COUNT = 36;
+    // Largeur des contours en pixels, moitié de chaque côté de l'arête
+    static constexpr float EDGE_WIDTH = 2.0f;
+    // Éclairage commun aux cubes et au champ de voxels (la vue ne sert qu'au spéculaire)
+    static const glm::vec3 LIGHT_POSITION;
+    static const glm::vec3 VIEW_POSITION;
+
     Cube();
     Cube(float x, float y, float z, glm::vec3 color = glm::vec3(0.5f, 0.5f, 0.5f));
     ~Cube();
 
     void setPosition(float x, float y, float z);
     void setColor(glm::vec3 color);
+    // Une draw call : les contours sont tracés par le fragment shader des faces
     void render(const glm::mat4& view, const glm::mat4& projection);
     
     glm::vec3 getPosition() const { return position; }
     glm::vec3 getColor() const { return color; }
 
 private:
-    void setupMesh();
-    void createShaders();
+    friend class ResidentCubes;
+    friend class CubeInstances;
+    friend class VoxelField;
 
     glm::vec3 position;
     glm::vec3 color;
     glm::vec3 rotation; 
     
-    unsigned int VAO, VBO, EBO;
-    unsigned int edgeVAO, edgeVBO;
-    unsigned int shaderProgram;
-    unsigned int edgeShaderProgram;
+    // Maillage et programmes partagés par tous les cubes : créés par le
+    // premier cube, détruits avec le dernier (compteur de références)
+    static int sharedUsers;
+    static unsigned int VAO, VBO, EBO;
+    static unsigned int shaderProgram;
+
+    static void acquireShared();
+    static void releaseShared();
+    static void setupMesh();
+    static void createShaders();
+    // Attributs 0 à 2 du maillage partagé, sur le VAO et le VBO liés
+    static void bindMeshAttributes();
+    static void useFaceProgram(const glm::mat4& model, const glm::mat4& view,
+                               const glm::mat4& projection, glm::vec3 color);
     
-    // Géométrie du cube avec les normales pour l'éclairage
+    // Géométrie du cube avec les normales pour l'éclairage et, par face, des
+    // coordonnées de 0 à 1 dont le fragment shader tire la distance aux arêtes
     static const float vertices[];
     static const unsigned int indices[];
-    
-    // Code source des shaders
-    static const char* vertexShaderSource;
-    static const char* fragmentShaderSource;
+};
+
+// Cubes mobiles dessinés en une draw call instanciée : position et couleur
+// par instance, copiées à chaque image dans l'anneau de flux du backend
+// (mosaïque, fantôme et pièce du puits)
+struct CubeInstance {
+    glm::vec3 offset;
+    glm::vec3 color;
+};
+
+class CubeInstances {
+public:
+    CubeInstances();
+    ~CubeInstances();
+
+    // Instances de l'image, dessinées par les deux appels suivants
+    void upload(const std::vector<CubeInstance>& instances);
+    // Contours de edgeWidth pixels (voir Cube::EDGE_WIDTH)
+    void render(const glm::mat4& view, const glm::mat4& projection,
+                const glm::vec3& lightPosition, const glm::vec3& viewPosition, float edgeWidth);
+    int size() const { return count; }
+
+private:
+    unsigned int VAO;
+    unsigned int shaderProgram;
+    size_t offset;
+    int count;
+
+    void bindInstances();
+};
+
+// Cubes gardés sur le GPU d'une image à l'autre, répartis en plages fixes
+// (pour le puits : murs et cellules de la pile). write() ne
+// renvoie que l'étendue qui diffère de la copie locale ; une instance de
+// couleur HIDDEN garde sa place sans être dessinée (cellule vide). Avec
+// GL 4.3, chaque plage est une commande d'un tampon indirect et toutes
+// partent en un seul glMultiDrawElementsIndirect ; sinon, une draw call
+// instanciée par plage non vide, les attributs d'instance pointés sur son début.
+class ResidentCubes {
+public:
+    static const glm::vec3 HIDDEN;
+
+    // Une plage par taille donnée, toutes ses instances masquées au départ
+    explicit ResidentCubes(const std::vector<int>& rangeSizes);
+    ~ResidentCubes();
+
+    // Remplace count instances de la plage range à partir de first
+    void write(int range, int first, const CubeInstance* instances, int count);
+    // Seules les count premières instances de la plage sont dessinées
+    void setDrawCount(int range, int count);
+    void render(const glm::mat4& view, const glm::mat4& projection,
+                const glm::vec3& lightPosition, const glm::vec3& viewPosition, float edgeWidth);
+
+    bool isIndirect() const { return indirect; }
+    // Instances renvoyées au GPU depuis la création
+    unsigned long long getPatchedInstances() const { return patchedInstances; }
+
+private:
+    struct Range {
+        int first;
+        int size;
+        int drawn;
+    };
+
+    std::vector<Range> ranges;
+    // Copie de ce que contient instanceBuffer
+    std::vector<CubeInstance> instances;
+    unsigned int VAO;
+    unsigned int instanceBuffer;
+    unsigned int commandBuffer;
+    unsigned int shaderProgram;
+    bool indirect;
+    bool commandsChanged;
+    unsigned long long patchedInstances;
+
+    void uploadCommands();
+    void bindRange(int first);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <glad/glad.h>
+
+// Résolution dynamique de la scène 3D : la scène est rendue dans un
+// framebuffer object réduit, puis agrandie (glBlitFramebuffer, filtrage
+// linéaire) vers le framebuffer de destination, où l'interface est ensuite
+// dessinée à la résolution native. Le temps GPU de la scène est mesuré par
+// des timestamps (qui s'imbriquent sans gêne avec les requêtes de GpuTimer),
+// lus sans attente quelques images plus tard ; l'échelle baisse dès que la
+// moyenne dépasse le budget et remonte d'un cran quand il reste de la marge.
+// À l'échelle 1, la scène va directement dans la destination.
+class DynamicResolution {
+public:
+    struct Options {
+        // Budget GPU de la scène en millisecondes (0 : résolution native)
+        float budgetMs = 0.0f;
+        float minScale = 0.5f;
+    };
+
+    static const int FRAMES_IN_FLIGHT = 4;
+    // Échelles quantifiées : le FBO n'est réalloué qu'à chaque cran franchi
+    static constexpr float SCALE_STEP = 0.05f;
+
+    // Retire de argv --frame-budget MS et --min-scale S ; false si une valeur est invalide
+    static bool parseArguments(int& argc, char** argv, Options& options);
+    static void printUsage();
+
+    explicit DynamicResolution(const Options& options);
+    ~DynamicResolution();
+
+    // Lie le FBO de la scène à l'échelle courante pour une destination de
+    // width x height pixels, règle le viewport et l'efface
+    void beginScene(int width, int height);
+    // Agrandit la scène dans la destination et y restaure le viewport natif
+    void endScene();
+
+    float getScale() const { return scale; }
+    int getSceneWidth() const { return sceneWidth; }
+    int getSceneHeight() const { return sceneHeight; }
+    // Moyenne glissante du temps GPU de la scène (0 avant le premier résultat)
+    float getSceneMs() const { return averageMs; }
+
+private:
+    float budgetMs;
+    float minScale;
+    float scale;
+    float averageMs;
+    int cooldown;
+
+    unsigned int framebuffer;
+    unsigned int colorBuffer;
+    unsigned int depthBuffer;
+    int bufferWidth;
+    int bufferHeight;
+
+    GLint target;
+    int targetWidth;
+    int targetHeight;
+    int sceneWidth;
+    int sceneHeight;
+
+    unsigned int queries[FRAMES_IN_FLIGHT][2];
+    bool issued[FRAMES_IN_FLIGHT];
+    int slot;
+    bool created;
+
+    void collect(int frameSlot);
+    void adjust(float sceneMs);
+    void resizeBuffers(int width, int height);
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <glad/glad.h>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Enregistrement vidéo du framebuffer. Chaque image est lue dans un anneau de
+// pixel buffer objects (glReadPixels asynchrone) et récupérée quelques images
+// plus tard, quand le GPU a fini : le pipeline ne s'arrête jamais. Un thread
+// convertit les pixels et les écrit en Y4M (fichier .y4m ou tube) ou en RGB24
+// brut. Si l'écriture ne suit pas, des images sont perdues plutôt que de
+// ralentir le rendu.
+class FrameCapture {
+public:
+    static const int PBO_COUNT = 3;
+    static const size_t MAX_QUEUED_FRAMES = 8;
+
+    FrameCapture();
+    ~FrameCapture();
+
+    // path : fichier (.y4m pour du Y4M, sinon RGB24 brut), « - » pour la sortie
+    // standard ou « |commande » pour un tube (Y4M), par ex. « |ffmpeg -i - out.mp4 »
+    bool start(const std::string& path, int width, int height, int fps);
+    void stop();
+    bool isRecording() const { return recording; }
+
+    // Après le rendu, avant glfwSwapBuffers : lit le framebuffer courant
+    void captureFrame();
+
+private:
+    struct Frame {
+        std::vector<unsigned char> pixels;
+    };
+
+    bool recording;
+    bool y4m;
+    bool pipe;
+    FILE* output;
+    int width;
+    int height;
+    size_t frameBytes;
+
+    GLuint pbos[PBO_COUNT];
+    GLsync fences[PBO_COUNT];
+    unsigned long long issued;
+    unsigned long long collected;
+
+    unsigned long long written;
+    unsigned long long dropped;
+    unsigned long long stalls;
+
+    // File partagée avec le thread d'écriture, tampons recyclés
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Frame*> queue;
+    std::vector<Frame*> freeFrames;
+    bool stopping;
+    std::thread writer;
+
+    void collect(int slot, bool wait);
+    void writerLoop();
+    void writeFrame(const Frame& frame, std::vector<unsigned char>& converted);
+};
+
+#endif
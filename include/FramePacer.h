@@ -0,0 +1,58 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+
+struct GLFWwindow;
+
+// Cadence les images en rendu continu : prédit le coût d'une image d'après
+// les précédentes, dort (sommeil puis attente active pour la dernière
+// milliseconde) jusqu'au dernier instant sûr avant la présentation suivante,
+// puis laisse la boucle lire les entrées et avancer la simulation. L'image
+// présentée contient ainsi les entrées les plus récentes. Sans vsync, la
+// période vient du plafond --fps-cap (aucune attente sans plafond).
+class FramePacer {
+public:
+    struct Options {
+        bool vsync = true;
+        double fpsCap = 0.0;
+        // Rendu à chaque image même si rien ne change (sinon rendu à la demande)
+        bool continuous = false;
+    };
+
+    static const int HISTORY = 32;
+
+    // Retire de argv les options du pacer (--continuous, --no-vsync, --fps-cap N) ;
+    // false si une valeur est invalide
+    static bool parseArguments(int& argc, char** argv, Options& options);
+    static void printUsage();
+
+    FramePacer(GLFWwindow* window, const Options& options);
+
+    // Attend le dernier instant sûr pour commencer l'image suivante
+    void waitForFrameStart();
+    // Entourent le travail de l'image (entrées, simulation, soumission du rendu)
+    void beginWork();
+    void endWork();
+    // Juste avant glfwSwapBuffers : tient le plafond d'images sans vsync
+    void waitForPresent();
+    // Juste après glfwSwapBuffers
+    void framePresented();
+
+    double getPeriodMs() const;
+    double getPredictedWorkMs() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    double periodSeconds;
+    bool vsync;
+    double workSamples[HISTORY];
+    int sampleCount;
+    int sampleIndex;
+    Clock::time_point workStart;
+    Clock::time_point nextPresent;
+    bool hasPresented;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef GL_BACKEND_H
+#define GL_BACKEND_H
+
+#include "RenderBackend.h"
+#include <string>
+#include <vector>
+
+class StreamBuffer;
+
+// Backend par défaut : chaque appel devient l'appel OpenGL correspondant, sauf
+// ceux qui ne changeraient rien. Le backend garde l'état GL qu'il a lui-même
+// posé (programme, VAO, tampons de sommets et de commandes, test de profondeur,
+// emplacements et valeurs des uniformes de chaque programme) et ne transmet
+// que les changements. Le VAO est lié paresseusement, juste avant l'appel qui
+// le lit : bindVertexArray(0) après une draw call ne coûte plus rien si la
+// suivante reprend le même. Le code qui appelle GL directement ne doit pas
+// toucher à cet état, hormis StreamBuffer dont la liaison est oubliée à chaque écriture.
+class GlBackend : public RenderBackend {
+public:
+    unsigned int createVertexArray() override;
+    void deleteVertexArray(unsigned int vertexArray) override;
+    unsigned int createBuffer() override;
+    void deleteBuffer(unsigned int buffer) override;
+    unsigned int createProgram(const char* vertexSource, const char* fragmentSource) override;
+    void deleteProgram(unsigned int program) override;
+    unsigned int createTexture() override;
+    void deleteTexture(unsigned int texture) override;
+
+    void bindVertexArray(unsigned int vertexArray) override;
+    void bindBuffer(BufferTarget target, unsigned int buffer) override;
+    void bufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) override;
+    void bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) override;
+    void acquireStream() override;
+    void releaseStream() override;
+    size_t streamData(const void* data, size_t size, size_t alignment) override;
+    unsigned int streamBuffer() override;
+    void vertexAttribute(unsigned int index, int components, size_t stride, size_t offset) override;
+    void instanceAttribute(unsigned int index, int components, size_t stride, size_t offset) override;
+
+    void bindTexture(int unit, unsigned int texture) override;
+    void textureImage(int width, int height, const void* data) override;
+    void textureSubImage(int firstRow, int width, int rows, const void* data) override;
+
+    void useProgram(unsigned int program) override;
+    void setUniform(unsigned int program, const char* name, const glm::mat4& value) override;
+    void setUniform(unsigned int program, const char* name, const glm::vec3& value) override;
+    void setUniform(unsigned int program, const char* name, int value) override;
+    void setUniform(unsigned int program, const char* name, float value) override;
+
+    void setDepthTest(bool enabled) override;
+    void drawArrays(Primitive primitive, int first, int count) override;
+    void drawElements(Primitive primitive, int count) override;
+    void drawElementsInstanced(Primitive primitive, int count, int instances) override;
+    bool supportsIndirectDraws() override;
+    void multiDrawElementsIndirect(Primitive primitive, size_t offset, int drawCount) override;
+    void endFrame() override;
+
+private:
+    // Valeur d'une liaison que le backend ne connaît pas (posée hors de lui)
+    static const unsigned int UNKNOWN = ~0u;
+
+    struct Uniform {
+        unsigned int program;
+        std::string name;
+        int location;
+        // Dernière valeur envoyée, octet pour octet (jusqu'à une mat4)
+        float value[16];
+        size_t size;
+    };
+
+    // Créé par le premier utilisateur, pendant que le contexte existe
+    StreamBuffer* stream = nullptr;
+    int streamUsers = 0;
+
+    unsigned int currentProgram = 0;
+    unsigned int boundVertexArray = 0;
+    unsigned int pendingVertexArray = 0;
+    unsigned int boundVertexBuffer = 0;
+    unsigned int boundIndirectBuffer = 0;
+    // -1 tant que le test de profondeur n'a pas été posé par le backend
+    int depthTest = -1;
+    std::vector<Uniform> uniforms;
+
+    void applyVertexArray();
+    // Emplacement de l'uniforme, ou -1 si sa valeur n'a pas changé depuis le dernier envoi
+    int changedUniform(unsigned int program, const char* name, const void* value, size_t size);
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef GL_STATS_H
+#define GL_STATS_H
+
+#include <glad/glad.h>
+#include <string>
+
+// Compteurs d'appels OpenGL par image. Une fois activé, les pointeurs de
+// fonction glad des points d'entrée utilisés par le rendu sont remplacés par
+// des versions qui comptent puis appellent le pilote ; désactivé, les
+// pointeurs d'origine sont restaurés et le coût est nul.
+//
+// À n'utiliser que depuis le thread qui possède le contexte GL.
+class GlStats {
+public:
+    struct Counters {
+        unsigned drawCalls = 0;
+        unsigned programBinds = 0;
+        unsigned vaoBinds = 0;
+        unsigned bufferUploads = 0;
+        unsigned long long bytesUploaded = 0;
+        unsigned uniformUpdates = 0;
+        unsigned uniformLookups = 0;
+        // Attentes de l'anneau de flux sur une région encore lue par le GPU
+        unsigned streamStalls = 0;
+    };
+
+    // csvPath vide : pas de journal, seulement les compteurs à l'écran
+    static bool enable(const std::string& csvPath);
+    static void disable();
+    static bool isEnabled();
+
+    // À appeler une fois par image, avant l'échange des buffers
+    static void endFrame();
+    static const Counters& lastFrame();
+    // Appelés par StreamBuffer, dont les écritures mappées échappent aux points d'entrée interceptés
+    static void countStreamUpload(size_t bytes);
+    static void countStreamStall();
+};
+
+#endif
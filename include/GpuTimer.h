@@ -0,0 +1,48 @@
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include <glad/glad.h>
+
+// Mesure le temps GPU de chaque passe avec des requêtes GL_TIME_ELAPSED.
+// Les requêtes tournent sur FRAMES_IN_FLIGHT images : un résultat n'est lu
+// que lorsqu'il est disponible, sans jamais attendre le GPU.
+class GpuTimer {
+public:
+    enum Pass { CUBES, HUD, PASS_COUNT };
+    static const int FRAMES_IN_FLIGHT = 4;
+
+    GpuTimer();
+    ~GpuTimer();
+
+    // Désactivé, le minuteur n'émet aucune requête (ni n'en crée)
+    void setEnabled(bool value);
+    bool isEnabled() const { return enabled; }
+
+    void beginFrame();
+    void begin(Pass pass);
+    void end();
+    void endFrame();
+
+    // Dernière image dont tous les résultats sont revenus
+    bool hasResults() const { return resultsReady; }
+    float getPassMs(Pass pass) const { return passMs[pass]; }
+    float getTotalMs() const;
+    unsigned getDroppedFrames() const { return droppedFrames; }
+
+    static const char* passName(Pass pass);
+
+private:
+    unsigned int queries[FRAMES_IN_FLIGHT][PASS_COUNT];
+    bool issued[FRAMES_IN_FLIGHT][PASS_COUNT];
+    int slot;
+    bool enabled;
+    bool active;
+    bool created;
+    float passMs[PASS_COUNT];
+    bool resultsReady;
+    unsigned droppedFrames;
+
+    void collect(int frameSlot);
+};
+
+#endif
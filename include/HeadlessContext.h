@@ -0,0 +1,47 @@
+#ifndef HEADLESS_CONTEXT_H
+#define HEADLESS_CONTEXT_H
+
+#include <string>
+
+// Contexte OpenGL sans fenêtre ni serveur d'affichage : EGL surfaceless
+// (Mesa llvmpipe convient), ou pbuffer si le pilote ne le propose pas. Le rendu
+// va dans un framebuffer object de la taille demandée, qui reste lié :
+// Board s'y dessine comme dans une fenêtre. Disponible seulement si CMake a
+// trouvé EGL (TETRIS3D_HEADLESS).
+class HeadlessContext {
+public:
+    struct Options {
+        bool enabled = false;
+        std::string screenshot;
+        std::string record;
+    };
+
+    // Retire de argv les options headless (--headless, --screenshot F, --record F)
+    static bool parseArguments(int& argc, char** argv, Options& options);
+    static void printUsage();
+    static bool isAvailable();
+
+    HeadlessContext();
+    ~HeadlessContext();
+
+    bool create(int width, int height);
+    void destroy();
+
+    // Image PPM binaire du framebuffer courant
+    bool writeScreenshot(const std::string& path) const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    void* display;
+    void* surface;
+    void* context;
+    unsigned int framebuffer;
+    unsigned int colorBuffer;
+    unsigned int depthBuffer;
+    int width;
+    int height;
+};
+
+#endif
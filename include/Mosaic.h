@@ -0,0 +1,95 @@
+#ifndef MOSAIC_H
+#define MOSAIC_H
+
+#include "Autoplayer.h"
+#include "Cube.h"
+#include "Simulation.h"
+#include "WorkStealingPool.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+class TextRenderer;
+
+// Mosaïque de 16 à 256 parties jouées par l'Autoplayer, pour les tournois de
+// bots et la surveillance. Chaque partie est une Simulation headless avancée
+// en parallèle sur le pool ; tous les cubes de toutes les parties (murs, pile,
+// pièces) sont dessinés en une draw call instanciée (contours compris) par
+// CubeInstances, avec la position et la couleur de chaque cube en
+// attribut d'instance. Les scores passent par un seul lot de texte.
+class Mosaic {
+public:
+    struct Options {
+        // 0 : pas de mosaïque
+        int boards = 0;
+    };
+
+    static const int MIN_BOARDS = 16;
+    static const int MAX_BOARDS = 256;
+    // Une action de l'Autoplayer par tick, gravité tous les GRAVITY_TICKS
+    static constexpr float TICK_SECONDS = 0.05f;
+    static const int GRAVITY_TICKS = 8;
+
+    // Retire --mosaic N de argv ; false si N est hors de [MIN_BOARDS, MAX_BOARDS]
+    static bool parseArguments(int& argc, char** argv, Options& options);
+    static void printUsage();
+
+    Mosaic(int boardCount, int screenWidth, int screenHeight,
+           int fieldWidth = Simulation::DEFAULT_WIDTH, int fieldHeight = Simulation::DEFAULT_HEIGHT);
+    ~Mosaic();
+
+    // Avance les parties du nombre de ticks écoulés (au plus quelques-uns par appel)
+    void update(float deltaTime);
+    void advance(int ticks);
+    void render();
+    // Nouvelle taille du framebuffer : grille, caméra et scores refaits à son format
+    void resize(int screenWidth, int screenHeight);
+
+    // Délai avant le prochain tick, pour l'attente de la boucle principale
+    double getNextTickDelay() const { return TICK_SECONDS - accumulator; }
+    unsigned getRevision() const { return revision; }
+    int getBoardCount() const { return static_cast<int>(games.size()); }
+    unsigned long long getGamesPlayed() const;
+    size_t getInstanceCount() const { return instances.size(); }
+
+private:
+    struct Game {
+        Simulation simulation;
+        Autoplayer::Placement target;
+        unsigned spawn;
+        int steps;
+        bool dropping;
+        int gravityTicks;
+        unsigned finished;
+        uint64_t seed;
+    };
+
+    std::vector<Game> games;
+    std::vector<glm::vec3> origins;
+    std::vector<glm::vec2> labelPositions;
+    std::vector<glm::vec3> wallPositions;
+    int fieldWidth;
+    int fieldHeight;
+    int screenHeight;
+    float labelScale;
+
+    Autoplayer player;
+    WorkStealingPool pool;
+    float accumulator;
+    unsigned revision;
+
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 cameraPosition;
+    glm::vec3 lightPosition;
+
+    CubeInstances* cubes;
+    std::vector<CubeInstance> instances;
+    std::vector<glm::vec4> labelRects;
+    TextRenderer* textRenderer;
+
+    void layout(int screenWidth, int screenHeight);
+    void tick(Game& game) const;
+    void collectInstances();
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef NEURAL_EVALUATOR_H
+#define NEURAL_EVALUATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Petit MLP quantifié (une couche cachée) évaluant un plateau à partir de son
+// occupation et de la hauteur des colonnes. Les calculs sont entiers (poids
+// int8 élargis en int16, accumulation int32) : la version SIMD et la version
+// scalaire donnent exactement le même résultat. La version SIMD évalue les
+// plateaux par tuiles de TILE, une voie de registre par plateau : chaque
+// ligne de poids est lue une fois pour toute la tuile.
+//
+// Une instance chargée n'est plus modifiée par l'évaluation : les buffers de
+// travail sont propres à chaque thread, et des Autoplayer exécutés sur
+// plusieurs threads peuvent partager le même évaluateur.
+class NeuralEvaluator {
+public:
+    static const int MAX_BATCH = 64;
+    // Plateaux évalués ensemble par le noyau SIMD
+    static const int TILE = 8;
+
+    NeuralEvaluator();
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+    static NeuralEvaluator createRandom(int width, int height, int hidden, uint64_t seed);
+
+    bool isLoaded() const { return hidden > 0; }
+    bool accepts(int width, int height) const { return isLoaded() && width == boardWidth && height == boardHeight; }
+    int getInputCount() const { return inputs; }
+    int getHiddenCount() const { return hidden; }
+    // Empreinte des dimensions et des poids, recalculée à chaque chargement :
+    // deux réseaux identiques ont la même, même à des adresses différentes
+    uint64_t getFingerprint() const { return fingerprint; }
+
+    void setUseSimd(bool enabled) { useSimd = enabled; }
+    static bool simdAvailable();
+    static const char* simdName();
+
+    // boards : count plateaux contigus de width * height octets (count <= MAX_BATCH)
+    void evaluateBatch(const uint8_t* boards, int count, float* scores) const;
+    float evaluate(const uint8_t* cells) const;
+
+private:
+    int boardWidth;
+    int boardHeight;
+    int inputs;
+    int paddedInputs;
+    int hidden;
+    int shift;
+    float outputScale;
+    bool useSimd;
+
+    // Poids int8 stockés en int16 pour _mm_madd_epi16, lignes alignées sur 16
+    // (un nombre pair d'entrées : le noyau SIMD les lit par paires)
+    std::vector<int16_t> weights1;
+    std::vector<int32_t> bias1;
+    std::vector<int16_t> weights2;
+    int32_t bias2;
+    uint64_t fingerprint;
+
+    void allocate(int width, int height, int hiddenCount);
+    void updateFingerprint();
+    void buildInputs(const uint8_t* cells, int16_t* input, int pairStride) const;
+    int32_t forwardScalar(const int16_t* input, int16_t* hiddenOut) const;
+    void forwardSimd(const int16_t* tile, int32_t* outputs) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef NULL_BACKEND_H
+#define NULL_BACKEND_H
+
+#include "RenderBackend.h"
+#include <vector>
+
+// Backend sans GL : les commandes d'une image sont ajoutées à une liste (avec
+// la valeur des uniformes) au lieu d'être exécutées. Le temps de Board::render
+// avec ce backend est le coût CPU du parcours de scène et de la construction
+// des commandes ; aucun contexte OpenGL n'est nécessaire.
+class NullBackend : public RenderBackend {
+public:
+    enum class CommandType {
+        BIND_VERTEX_ARRAY, BIND_BUFFER, BUFFER_DATA, BUFFER_SUB_DATA, STREAM_DATA, VERTEX_ATTRIBUTE,
+        INSTANCE_ATTRIBUTE, BIND_TEXTURE, TEXTURE_IMAGE, TEXTURE_SUB_IMAGE, USE_PROGRAM, SET_UNIFORM, SET_DEPTH_TEST,
+        DRAW_ARRAYS, DRAW_ELEMENTS, DRAW_ELEMENTS_INSTANCED, MULTI_DRAW_ELEMENTS_INDIRECT,
+        COUNT
+    };
+
+    struct Command {
+        CommandType type;
+        unsigned int object;
+        // Sommets ou indices (toutes instances comprises), octets envoyés, position de la valeur
+        // d'uniforme, ou nombre de commandes d'une multi-draw indirecte
+        size_t size;
+    };
+
+    NullBackend();
+
+    // Début d'image : vide la liste
+    void clear();
+    const std::vector<Command>& getCommands() const { return commands; }
+    size_t getCount(CommandType type) const;
+
+    unsigned int createVertexArray() override;
+    void deleteVertexArray(unsigned int) override {}
+    unsigned int createBuffer() override;
+    void deleteBuffer(unsigned int) override {}
+    unsigned int createProgram(const char* vertexSource, const char* fragmentSource) override;
+    void deleteProgram(unsigned int) override {}
+    unsigned int createTexture() override;
+    void deleteTexture(unsigned int) override {}
+
+    void bindVertexArray(unsigned int vertexArray) override;
+    void bindBuffer(BufferTarget target, unsigned int buffer) override;
+    void bufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) override;
+    void bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) override;
+    void acquireStream() override {}
+    void releaseStream() override {}
+    size_t streamData(const void* data, size_t size, size_t alignment) override;
+    unsigned int streamBuffer() override;
+    void vertexAttribute(unsigned int index, int components, size_t stride, size_t offset) override;
+    void instanceAttribute(unsigned int index, int components, size_t stride, size_t offset) override;
+
+    void bindTexture(int unit, unsigned int texture) override;
+    void textureImage(int width, int height, const void* data) override;
+    void textureSubImage(int firstRow, int width, int rows, const void* data) override;
+
+    void useProgram(unsigned int program) override;
+    void setUniform(unsigned int program, const char* name, const glm::mat4& value) override;
+    void setUniform(unsigned int program, const char* name, const glm::vec3& value) override;
+    void setUniform(unsigned int program, const char* name, int value) override;
+    void setUniform(unsigned int program, const char* name, float value) override;
+
+    void setDepthTest(bool enabled) override;
+    void drawArrays(Primitive primitive, int first, int count) override;
+    void drawElements(Primitive primitive, int count) override;
+    void drawElementsInstanced(Primitive primitive, int count, int instances) override;
+    // Le chemin indirect est celui dont on mesure le coût CPU
+    bool supportsIndirectDraws() override { return true; }
+    void multiDrawElementsIndirect(Primitive primitive, size_t offset, int drawCount) override;
+    void endFrame() override { streamUsed = 0; }
+
+private:
+    std::vector<Command> commands;
+    std::vector<float> uniformValues;
+    unsigned int nextObject;
+    // Anneau de flux simulé : seuls les offsets avancent
+    unsigned int stream;
+    size_t streamUsed;
+
+    void record(CommandType type, unsigned int object, size_t size);
+};
+
+#endif
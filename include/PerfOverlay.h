@@ -0,0 +1,42 @@
+#ifndef PERF_OVERLAY_H
+#define PERF_OVERLAY_H
+
+#include "GpuTimer.h"
+#include "TextRenderer.h"
+
+// Graphe glissant du temps d'image et détail CPU / GPU par passe, pour
+// distinguer une image lente côté soumission CPU d'une image limitée par le GPU
+class PerfOverlay {
+public:
+    static const int HISTORY = 120;
+
+    PerfOverlay();
+
+    // frameMs : temps entre deux images ; cpuMs : soumission des commandes de rendu
+    void addSample(float frameMs, float cpuMs, const GpuTimer& timer);
+    // Échelle de la résolution dynamique, affichée au-dessus du temps d'image (0 : masquée)
+    void setResolutionScale(float scale) { resolutionScale = scale; }
+    // Taux de succès et remplissage de la table de transposition du Ponderer (< 0 : masqués)
+    void setTableStats(float hitRate, float occupancy) {
+        tableHitRate = hitRate;
+        tableOccupancy = occupancy;
+    }
+    void render(TextRenderer& text, float x, float y) const;
+
+private:
+    float frameHistory[HISTORY];
+    float gpuHistory[HISTORY];
+    int head;
+    int count;
+
+    float lastFrameMs;
+    float lastCpuMs;
+    bool gpuValid;
+    float gpuPassMs[GpuTimer::PASS_COUNT];
+    float gpuTotalMs;
+    float resolutionScale;
+    float tableHitRate;
+    float tableOccupancy;
+};
+
+#endif
@@ -1,7 +1,6 @@
 #ifndef PIECE_H
 #define PIECE_H
 
-#include "Cube.h"
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -12,9 +11,7 @@ enum class PieceType {
 class Piece {
 public:
     Piece(PieceType type, float x, float y);
-    ~Piece();
     
-    void render(const glm::mat4& view, const glm::mat4& projection);
     void move(float dx, float dy);
     void setPosition(float x, float y);
     void rotate(); 
@@ -22,16 +19,21 @@ public:
     
     std::vector<glm::vec2> getBlockPositions() const;
     glm::vec3 getColor() const { return color; }
+    PieceType getType() const { return type; }
+    int getRotation() const { return rotation; }
+    float getX() const { return x; }
+    float getY() const { return y; }
+    
+    static glm::vec3 colorFor(PieceType type);
     
 private:
     void initializePiece(PieceType type);
-    void updateCubePositions();
     glm::vec3 getRandomColor();
     
     PieceType type;
     float x, y;
+    int rotation;
     std::vector<glm::vec2> shape;
-    std::vector<Cube*> cubes;
     glm::vec3 color;
 };
 
@@ -0,0 +1,64 @@
+#ifndef PONDERER_H
+#define PONDERER_H
+
+#include "Autoplayer.h"
+#include "Simulation.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Recherche en arrière-plan pendant la chute de la pièce. Le thread de rendu
+// soumet l'état à chaque nouvelle pièce puis lit le résultat sans attendre ;
+// le worker enchaîne sur les états suivants les plus probables (le meilleur
+// placement joué) pour que la réponse soit déjà prête à l'apparition.
+class Ponderer {
+public:
+    Ponderer(const Autoplayer::Weights& weights = Autoplayer::defaultWeights(),
+             int depth = 2, int speculation = 2);
+    ~Ponderer();
+
+    Ponderer(const Ponderer&) = delete;
+    Ponderer& operator=(const Ponderer&) = delete;
+
+    // Retourne la clé à passer à getResult pour cet état
+    uint64_t submit(const Simulation& state);
+    bool getResult(uint64_t key, Autoplayer::Placement& placement) const;
+
+    static uint64_t keyFor(const Simulation& state);
+
+    // Demandes dont le résultat était déjà prêt au moment de la soumission
+    unsigned long long getReadyOnSubmit() const { return readyOnSubmit.load(); }
+    unsigned long long getSubmitCount() const { return submitCount.load(); }
+    TranspositionTable::Stats getTableStats() const { return table.getStats(); }
+
+private:
+    static const size_t MAX_RESULTS = 16;
+
+    TranspositionTable table;
+    Autoplayer player;
+    int speculation;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    Simulation pending;
+    bool hasPending;
+    bool stopping;
+    std::atomic<unsigned long long> generation;
+    std::deque<std::pair<uint64_t, Autoplayer::Placement>> results;
+
+    std::atomic<unsigned long long> readyOnSubmit;
+    std::atomic<unsigned long long> submitCount;
+
+    std::thread worker;
+
+    bool findResult(uint64_t key, Autoplayer::Placement& placement) const;
+    void storeResult(uint64_t key, const Autoplayer::Placement& placement);
+    void workerLoop();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <string>
+
+// Zones de temps CPU écrites dans un buffer circulaire par thread (un seul
+// écrivain, aucun verrou sur le chemin chaud) et exportées à la demande au
+// format Chrome trace / Perfetto. Compilé seulement avec TETRIS3D_PROFILER :
+// sinon les macros ne génèrent aucun code.
+//
+// Les noms de zones doivent avoir une durée de vie statique (littéraux).
+class Profiler {
+public:
+    static const size_t EVENTS_PER_THREAD = 1 << 16;
+
+    class Zone {
+    public:
+        explicit Zone(const char* name) : name(name), start(now()) {}
+        ~Zone() { record(name, start, now()); }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* name;
+        uint64_t start;
+    };
+
+    static uint64_t now();
+    static void record(const char* name, uint64_t start, uint64_t end);
+    static void setThreadName(const char* name);
+
+    static bool isEnabled();
+    static bool dumpChromeTrace(const std::string& path);
+};
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+#ifdef TETRIS3D_PROFILER
+#define PROFILE_ZONE(name) Profiler::Zone PROFILER_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) Profiler::setThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif
\ No newline at end of file
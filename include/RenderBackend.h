@@ -0,0 +1,78 @@
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+
+// Interface des appels de rendu de Cube, TextRenderer et Board. GlBackend les
+// transmet à OpenGL ; NullBackend les enregistre sans jamais appeler GL, pour
+// séparer le coût CPU du parcours de scène et de la construction des commandes
+// de celui du pilote et du GPU. Le backend courant est global (un seul contexte).
+class RenderBackend {
+public:
+    enum class Primitive { TRIANGLES };
+    // INDIRECT : commandes des multi-draws indirectes (GL_DRAW_INDIRECT_BUFFER)
+    enum class BufferTarget { VERTICES, INDICES, INDIRECT };
+    enum class BufferUsage { STATIC, DYNAMIC };
+
+    virtual ~RenderBackend() {}
+
+    virtual unsigned int createVertexArray() = 0;
+    virtual void deleteVertexArray(unsigned int vertexArray) = 0;
+    virtual unsigned int createBuffer() = 0;
+    virtual void deleteBuffer(unsigned int buffer) = 0;
+    // 0 si la compilation échoue
+    virtual unsigned int createProgram(const char* vertexSource, const char* fragmentSource) = 0;
+    virtual void deleteProgram(unsigned int program) = 0;
+    // Textures 2D d'octets entiers (R8UI), lues sans filtrage (texelFetch)
+    virtual unsigned int createTexture() = 0;
+    virtual void deleteTexture(unsigned int texture) = 0;
+
+    virtual void bindVertexArray(unsigned int vertexArray) = 0;
+    virtual void bindBuffer(BufferTarget target, unsigned int buffer) = 0;
+    virtual void bufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) = 0;
+    virtual void bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) = 0;
+    // Anneau de flux des données réécrites à chaque image (texte, instances) :
+    // chaque utilisateur l'acquiert et le libère, le dernier le détruit
+    virtual void acquireStream() = 0;
+    virtual void releaseStream() = 0;
+    // Copie size octets dans la région de l'image courante et renvoie leur
+    // offset dans streamBuffer(), multiple de alignment
+    virtual size_t streamData(const void* data, size_t size, size_t alignment) = 0;
+    virtual unsigned int streamBuffer() = 0;
+    // Attribut de flottants lu dans le tampon de sommets lié (stride et offset en octets)
+    virtual void vertexAttribute(unsigned int index, int components, size_t stride, size_t offset) = 0;
+    // Idem, mais avancé d'un élément par instance plutôt que par sommet
+    virtual void instanceAttribute(unsigned int index, int components, size_t stride, size_t offset) = 0;
+
+    virtual void bindTexture(int unit, unsigned int texture) = 0;
+    // Sur la texture liée : allocation complète, puis mise à jour de lignes
+    virtual void textureImage(int width, int height, const void* data) = 0;
+    virtual void textureSubImage(int firstRow, int width, int rows, const void* data) = 0;
+
+    virtual void useProgram(unsigned int program) = 0;
+    virtual void setUniform(unsigned int program, const char* name, const glm::mat4& value) = 0;
+    virtual void setUniform(unsigned int program, const char* name, const glm::vec3& value) = 0;
+    virtual void setUniform(unsigned int program, const char* name, int value) = 0;
+    virtual void setUniform(unsigned int program, const char* name, float value) = 0;
+
+    virtual void setDepthTest(bool enabled) = 0;
+    virtual void drawArrays(Primitive primitive, int first, int count) = 0;
+    // Indices unsigned int depuis le début du tampon d'indices du VAO lié
+    virtual void drawElements(Primitive primitive, int count) = 0;
+    virtual void drawElementsInstanced(Primitive primitive, int count, int instances) = 0;
+    // GL 4.3 : multi-draw lue dans le tampon INDIRECT lié, à partir de offset
+    // octets (commandes de glMultiDrawElementsIndirect, base d'instance comprise)
+    virtual bool supportsIndirectDraws() = 0;
+    virtual void multiDrawElementsIndirect(Primitive primitive, size_t offset, int drawCount) = 0;
+    // Fin d'une image : la région de flux écrite reste réservée au GPU jusqu'à sa
+    // lecture. Appelée par la boucle d'images après la soumission, hors des
+    // mesures du temps CPU de rendu (la fence vide la file de commandes du pilote)
+    virtual void endFrame() = 0;
+
+    static RenderBackend& current();
+    // nullptr rétablit le backend OpenGL
+    static void setCurrent(RenderBackend* backend);
+};
+
+#endif
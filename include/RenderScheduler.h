@@ -0,0 +1,36 @@
+#ifndef RENDER_SCHEDULER_H
+#define RENDER_SCHEDULER_H
+
+struct GLFWwindow;
+
+// Rendu à la demande : une image n'est rendue que si quelque chose de visible
+// a changé (révision du plateau, redimensionnement, fenêtre réexposée), ou à
+// chaque tour en mode continu (overlays de performance). Entre deux rendus, la
+// boucle dort dans glfwWaitEventsTimeout jusqu'à la prochaine échéance
+// (gravité, autoplay) au lieu de redessiner une scène figée à chaque vsync.
+class RenderScheduler {
+public:
+    // Réveil de sécurité sans échéance : rechargement des shaders, résultats du Ponderer
+    static constexpr double MAX_IDLE_SECONDS = 0.25;
+
+    explicit RenderScheduler(GLFWwindow* window);
+
+    void requestRedraw() { redrawRequested = true; }
+    void setContinuous(bool enabled) { continuous = enabled; }
+    bool isContinuous() const { return continuous; }
+
+    bool shouldRender(unsigned revision) const;
+    void rendered(unsigned revision);
+
+    // Traite les événements en attendant au plus `timeout` secondes (< 0 :
+    // pas d'échéance) ; ne bloque pas en mode continu ou si un rendu est dû
+    void waitEvents(double timeout, unsigned revision);
+
+private:
+    GLFWwindow* window;
+    unsigned renderedRevision;
+    bool redrawRequested;
+    bool continuous;
+};
+
+#endif
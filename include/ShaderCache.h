@@ -0,0 +1,29 @@
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+#include <glad/glad.h>
+#include <string>
+
+// Compile et lie les programmes GLSL, en conservant sur disque le binaire
+// du programme lié (glGetProgramBinary). La clé combine les sources et les
+// chaînes vendor/renderer/version du pilote : un changement de pilote ou de
+// shader invalide l'entrée, et un binaire refusé est simplement recompilé.
+class ShaderCache {
+public:
+    struct Stats {
+        unsigned loaded = 0;
+        unsigned compiled = 0;
+        unsigned rejected = 0;
+        double milliseconds = 0.0;
+    };
+
+    // Répertoire : $TETRIS3D_SHADER_CACHE (« off » désactive le cache),
+    // sinon $XDG_CACHE_HOME/tetris3d ou ~/.cache/tetris3d. Vide = désactivé.
+    static void setDirectory(const std::string& path);
+
+    // Programme lié, ou 0 si la compilation échoue
+    static GLuint buildProgram(const char* vertexSource, const char* fragmentSource);
+    static const Stats& getStats();
+};
+
+#endif
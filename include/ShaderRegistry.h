@@ -0,0 +1,28 @@
+#ifndef SHADER_REGISTRY_H
+#define SHADER_REGISTRY_H
+
+#include <string>
+
+// Programmes GLSL construits à partir des fichiers de shaders/. En Release,
+// les fichiers sont intégrés à l'exécutable à la compilation ; sinon (ou si
+// $TETRIS3D_SHADER_DIR est défini) ils sont lus sur le disque et surveillés
+// par un thread (inotify sous Linux) : les programmes modifiés sont
+// recompilés entre deux images par reloadChanged(), sans redémarrer.
+class ShaderRegistry {
+public:
+    // *program reçoit le programme lié, puis chaque version rechargée ;
+    // il doit rester valide jusqu'à release()
+    static void load(const char* vertexFile, const char* fragmentFile, unsigned int* program);
+    static void release(unsigned int* program);
+
+    static void startWatching();
+    static void stopWatching();
+    // Thread OpenGL uniquement ; retourne le nombre de programmes rechargés
+    static int reloadChanged();
+
+    static bool isEmbedded();
+    // Vide quand les shaders intégrés sont utilisés
+    static const std::string& getDirectory();
+};
+
+#endif
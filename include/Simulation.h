@@ -0,0 +1,97 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "Piece.h"
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+enum class GameState {
+    WAITING_TO_START,
+    PLAYING,
+    GAME_OVER
+};
+
+enum class Action {
+    NONE = 0,
+    LEFT = 1,
+    RIGHT = 2,
+    ROTATE = 3,
+    SOFT_DROP = 4,
+    HARD_DROP = 5
+};
+
+// Logique du jeu sans aucune dépendance OpenGL : utilisée par Board pour
+// l'affichage et par la bibliothèque TetrisEnv pour les simulations headless.
+class Simulation {
+public:
+    static const int DEFAULT_WIDTH = 10;
+    static const int DEFAULT_HEIGHT = 20;
+    static const int QUEUE_SIZE = 5;
+    static const int PIECE_COUNT = 6;
+
+    Simulation(int width = DEFAULT_WIDTH, int height = DEFAULT_HEIGHT, uint64_t seed = 0);
+    Simulation(const Simulation& other);
+    Simulation& operator=(const Simulation& other);
+    ~Simulation();
+
+    void reset();
+    void reset(uint64_t seed);
+    void start();
+    int step(Action action);
+
+    void moveCurrentPiece(int dx, int dy);
+    void rotateCurrentPiece();
+    void hardDrop();
+    void update();
+    bool isValidPosition(const std::vector<glm::vec2>& positions) const;
+
+    // Les cellules sont écrites directement dans le buffer fourni (row-major,
+    // width * height octets, 0 = vide, sinon type de pièce + 1).
+    void bindCells(uint8_t* buffer);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    uint8_t getCell(int x, int y) const { return cells[y * width + x]; }
+    void setCell(int x, int y, uint8_t value) { cells[y * width + x] = value; }
+    const uint8_t* getCells() const { return cells; }
+    const Piece* getCurrentPiece() const { return currentPiece; }
+    PieceType getQueuedPiece(int index) const { return queue[(queueHead + index) % QUEUE_SIZE]; }
+
+    GameState getGameState() const { return gameState; }
+    int getScore() const { return score; }
+    int getLinesCleared() const { return linesCleared; }
+    // Nombre de pièces apparues depuis le dernier reset
+    unsigned getSpawnCount() const { return spawnCount; }
+
+private:
+    int width;
+    int height;
+    std::vector<uint8_t> storage;
+    uint8_t* cells;
+
+    Piece* currentPiece;
+    PieceType queue[QUEUE_SIZE];
+    int queueHead;
+    GameState gameState;
+    int score;
+    int linesCleared;
+    unsigned spawnCount;
+
+    std::mt19937 rng;
+    std::uniform_int_distribution<int> pieceDist;
+
+    void copyFrom(const Simulation& other);
+    void clearField();
+    void fillQueue();
+    PieceType nextQueuedPiece();
+    void spawnNewPiece();
+    void lockCurrentPiece();
+    void checkAndClearLines();
+    bool isLineFull(int line) const;
+    void clearLine(int line);
+    void dropLinesAbove(int clearedLine);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,14 @@
+#ifndef STARTUP_REPORT_H
+#define STARTUP_REPORT_H
+
+// Durée de chaque phase du démarrage, depuis le lancement du processus
+// jusqu'à la première image présentée. Chaque mark() clôt la phase en cours ;
+// le rapport est affiché une seule fois, à la première image.
+class StartupReport {
+public:
+    static void mark(const char* phase);
+    static void firstFramePresented();
+    static bool isComplete();
+};
+
+#endif
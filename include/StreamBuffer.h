@@ -0,0 +1,56 @@
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <glad/glad.h>
+#include <cstddef>
+
+// Anneau de flux pour les données de sommets réécrites à chaque image (texte,
+// instances de la mosaïque, pièce et fantôme). Un seul grand tampon découpé en
+// REGION_COUNT régions, une par image en vol : chaque image écrit à la suite
+// dans sa région, puis une fence la protège jusqu'à ce que le GPU l'ait lue.
+// Le tampon est mappé une fois pour toutes (glBufferStorage persistant et
+// cohérent, GL 4.4) ; sinon chaque écriture passe par un glMapBufferRange non
+// synchronisé, les fences garantissant qu'aucune région lue n'est écrasée.
+// Quand le GPU a trop de retard, l'attente de la fence est comptée comme
+// décrochage (GlStats et totaux).
+class StreamBuffer {
+public:
+    static const int REGION_COUNT = 3;
+    static const size_t INITIAL_REGION_SIZE = 1 << 20;
+
+    struct Totals {
+        unsigned long long bytes = 0;
+        unsigned long long stalls = 0;
+        double stallMs = 0.0;
+        unsigned grows = 0;
+        bool persistent = false;
+    };
+
+    StreamBuffer();
+    ~StreamBuffer();
+
+    // Copie size octets dans la région de l'image courante ; renvoie leur
+    // offset dans getBuffer(), multiple de alignment
+    size_t write(const void* data, size_t size, size_t alignment);
+    unsigned int getBuffer() const { return buffer; }
+    void endFrame();
+
+    // Cumul de tous les anneaux du processus
+    static const Totals& totals();
+
+private:
+    unsigned int buffer;
+    unsigned char* mapped;
+    bool persistent;
+    size_t regionSize;
+    int region;
+    size_t used;
+    bool touched;
+    GLsync fences[REGION_COUNT];
+
+    void create(size_t size);
+    void destroy();
+    void waitForRegion(int index);
+};
+
+#endif
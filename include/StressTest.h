@@ -0,0 +1,32 @@
+#ifndef STRESS_TEST_H
+#define STRESS_TEST_H
+
+#include <string>
+
+struct GLFWwindow;
+class Board;
+
+// Mode de qualification du matériel : remplit le puits selon un motif, rend
+// un nombre fixe d'images sans vsync puis affiche les percentiles du temps
+// d'image, le nombre de draw calls et le temps CPU par image.
+class StressTest {
+public:
+    struct Options {
+        bool enabled = false;
+        int frames = 1000;
+        int warmupFrames = 60;
+        int width = 10;
+        int height = 20;
+        std::string pattern = "half";
+        bool vsync = false;
+    };
+
+    // Retourne false (et affiche l'usage) si un argument est invalide
+    static bool parseArguments(int argc, char** argv, Options& options);
+    static void printUsage();
+
+    static bool fillPattern(Board& board, const std::string& pattern);
+    static int run(GLFWwindow* window, Board& board, const Options& options);
+};
+
+#endif
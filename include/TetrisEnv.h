@@ -0,0 +1,68 @@
+#ifndef TETRIS_ENV_H
+#define TETRIS_ENV_H
+
+/*
+ * Interface C de la simulation, pour piloter un lot d'environnements depuis
+ * ctypes/FFI. Les observations sont écrites directement dans les buffers
+ * contigus fournis par l'appelant via tetris_env_bind_buffers :
+ *
+ *   cells   : uint8  [num_envs][height][width]  0 = vide, sinon pièce + 1
+ *   pieces  : int32  [num_envs][TETRIS_ENV_PIECE_FIELDS]  type, x, y, rotation
+ *             (type = -1 quand aucune pièce n'est active)
+ *   queues  : int8   [num_envs][TETRIS_ENV_QUEUE_SIZE]
+ *   rewards : float  [num_envs]  points gagnés pendant le dernier pas
+ *   dones   : uint8  [num_envs]  1 quand la partie est terminée
+ *
+ * Les fonctions qui retournent un int renvoient 0 en cas de succès et -1
+ * en cas d'erreur.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define TETRIS_ENV_API __declspec(dllexport)
+#else
+#define TETRIS_ENV_API __attribute__((visibility("default")))
+#endif
+
+#define TETRIS_ENV_QUEUE_SIZE 5
+#define TETRIS_ENV_PIECE_FIELDS 4
+
+enum {
+    TETRIS_ACTION_NONE = 0,
+    TETRIS_ACTION_LEFT = 1,
+    TETRIS_ACTION_RIGHT = 2,
+    TETRIS_ACTION_ROTATE = 3,
+    TETRIS_ACTION_SOFT_DROP = 4,
+    TETRIS_ACTION_HARD_DROP = 5
+};
+
+typedef struct TetrisEnv TetrisEnv;
+
+/* width / height à 0 : dimensions par défaut du plateau (10 x 20) */
+TETRIS_ENV_API TetrisEnv* tetris_env_create(int num_envs, int width, int height);
+TETRIS_ENV_API void tetris_env_destroy(TetrisEnv* env);
+
+TETRIS_ENV_API int tetris_env_num_envs(const TetrisEnv* env);
+TETRIS_ENV_API int tetris_env_width(const TetrisEnv* env);
+TETRIS_ENV_API int tetris_env_height(const TetrisEnv* env);
+
+TETRIS_ENV_API int tetris_env_bind_buffers(TetrisEnv* env, uint8_t* cells, int32_t* pieces,
+                                           int8_t* queues, float* rewards, uint8_t* dones);
+
+TETRIS_ENV_API int tetris_env_reset(TetrisEnv* env, const uint64_t* seeds);
+TETRIS_ENV_API int tetris_env_reset_one(TetrisEnv* env, int index, uint64_t seed);
+
+/* Un pas = une action par environnement puis une descente par gravité.
+ * Les environnements terminés ignorent leur action jusqu'au prochain reset. */
+TETRIS_ENV_API int tetris_env_step(TetrisEnv* env, const int32_t* actions);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -1,9 +1,9 @@
 #ifndef TEXT_RENDERER_H
 #define TEXT_RENDERER_H
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
 
 class TextRenderer {
 public:
@@ -11,12 +11,35 @@ public:
     ~TextRenderer();
     
     void renderText(const std::string& text, float x, float y, float scale, glm::vec3 color);
+    // Ajoute les pixels allumés d'un texte à un lot dessiné ensuite par renderRects
+    static void appendText(std::vector<glm::vec4>& rects, const std::string& text, float x, float y, float scale);
+    // File de l'interface : les textes sont classés par couleur, seul état qui
+    // les distingue (même programme, même VAO), et flush envoie une draw call
+    // par couleur. Les textes d'une file ne doivent pas se chevaucher.
+    void queueText(const std::string& text, float x, float y, float scale, glm::vec3 color);
+    void flush();
+    void renderRect(float x, float y, float width, float height, glm::vec3 color);
+    // Rectangles (x, y, largeur, hauteur) d'une même couleur, par lots
+    void renderRects(const std::vector<glm::vec4>& rects, glm::vec3 color);
     void setProjection(int screenWidth, int screenHeight);
+    // Interface conçue pour layoutWidth x layoutHeight, agrandie uniformément
+    // dans le framebuffer et centrée (la marge va du côté le plus large)
+    void fitLayout(int screenWidth, int screenHeight, float layoutWidth, float layoutHeight);
 
 private:
-    unsigned int VAO, VBO;
+    unsigned int VAO;
     unsigned int shaderProgram;
     glm::mat4 projection;
+    std::vector<glm::vec4> rectScratch;
+    std::vector<float> vertices;
+    
+    struct Batch {
+        glm::vec3 color;
+        std::vector<glm::vec4> rects;
+    };
+    // Lots gardés d'une image à l'autre pour réutiliser leur mémoire
+    std::vector<Batch> batches;
+    size_t queuedBatches;
     
     void initShaders();
     void initBuffers();
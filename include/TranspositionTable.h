@@ -0,0 +1,73 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include "Piece.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Table de transposition de taille fixe partagée entre threads de recherche,
+// sans verrou : chaque entrée stocke (clé ^ données, données) et une lecture
+// déchirée par une écriture concurrente ne passe pas la vérification de clé.
+class TranspositionTable {
+public:
+    static const int BUCKET_SIZE = 4;
+
+    struct Stats {
+        unsigned long long probes;
+        unsigned long long hits;
+        unsigned long long stores;
+        size_t capacity;
+        size_t used;
+
+        double hitRate() const { return probes ? static_cast<double>(hits) / probes : 0.0; }
+        double occupancy() const { return capacity ? static_cast<double>(used) / capacity : 0.0; }
+    };
+
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    bool probe(uint64_t key, int depth, float& score);
+    void store(uint64_t key, int depth, float score);
+
+    // Les entrées des recherches précédentes deviennent remplaçables en priorité
+    void newSearch() { generation.fetch_add(1, std::memory_order_relaxed); }
+    void clear();
+
+    Stats getStats() const;
+    void resetStats();
+
+    // Empreinte 64 bits de l'occupation du plateau et des pièces à placer
+    static uint64_t hashPosition(const uint8_t* cells, int width, int height,
+                                 const PieceType* pieces, int pieceCount);
+    // Empreinte des paramètres de l'évaluation (poids, graine), à combiner par
+    // xor avec hashPosition quand des évaluations différentes partagent la table
+    static uint64_t hashParameters(const float* values, int count, uint64_t seed);
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> keyXorData;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Entry entries[BUCKET_SIZE];
+    };
+
+    std::unique_ptr<Bucket[]> buckets;
+    size_t bucketCount;
+    std::atomic<uint8_t> generation;
+
+    std::atomic<unsigned long long> probes;
+    std::atomic<unsigned long long> hits;
+    std::atomic<unsigned long long> stores;
+    // Entrées occupées, compté à l'écriture : getStats ne parcourt pas la table
+    std::atomic<size_t> used;
+
+    Bucket& bucketFor(uint64_t key) { return buckets[key & (bucketCount - 1)]; }
+};
+
+#endif
\ No newline at end of file
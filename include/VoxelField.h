@@ -0,0 +1,44 @@
+#ifndef VOXEL_FIELD_H
+#define VOXEL_FIELD_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Rendu de la pile par lancer de rayons, pour les très grands puits : les
+// cellules sont une texture R8UI (type de pièce + 1) et la boîte englobante du
+// puits est dessinée une seule fois ; le fragment shader parcourt la grille
+// (DDA) jusqu'à la première cellule pleine, l'éclaire comme un cube et trace
+// ses arêtes. Le coût dépend des pixels couverts, pas du nombre de cellules.
+// Seules les lignes modifiées depuis l'image précédente sont renvoyées au GPU.
+class VoxelField {
+public:
+    struct Options {
+        bool enabled = false;
+    };
+
+    // Retire --voxel de argv
+    static bool parseArguments(int& argc, char** argv, Options& options);
+    static void printUsage();
+
+    VoxelField(int width, int height);
+    ~VoxelField();
+
+    // Compare aux cellules déjà envoyées et met à jour les lignes qui diffèrent
+    void update(const uint8_t* cells);
+    void render(const glm::mat4& view, const glm::mat4& projection, int viewportHeight);
+
+    unsigned long long getUploadedRows() const { return uploadedRows; }
+
+private:
+    int width;
+    int height;
+    std::vector<uint8_t> uploaded;
+    unsigned long long uploadedRows;
+
+    unsigned int texture;
+    unsigned int shaderProgram;
+    glm::mat4 model;
+};
+
+#endif
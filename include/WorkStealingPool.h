@@ -0,0 +1,54 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads où chaque worker a sa propre file : il dépile ses tâches
+// par la fin et, quand elle est vide, en vole au début de la file d'un autre.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task);
+    void wait();
+
+    unsigned getThreadCount() const { return static_cast<unsigned>(workers.size()); }
+    unsigned long long getStealCount() const { return steals.load(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    std::atomic<size_t> pending;
+    std::atomic<unsigned> nextQueue;
+    std::atomic<unsigned long long> steals;
+    std::atomic<size_t> queued;
+    bool stopping;
+
+    void workerLoop(unsigned index);
+    bool popLocal(unsigned index, Task& task);
+    bool steal(unsigned index, Task& task);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 FaceUV;
+in vec3 CubeColor;
+
+uniform vec3 lightPos;
+uniform vec3 lightColor;
+uniform vec3 viewPos;
+// Largeur du contour en pixels, partagée entre les deux faces d'une arête
+uniform float edgeWidth;
+
+void main() {
+    float ambientStrength = 0.4;
+    vec3 ambient = ambientStrength * lightColor;
+    
+    vec3 norm = normalize(Normal);
+    vec3 lightDir = normalize(lightPos - FragPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * lightColor;
+    
+    float specularStrength = 0.1;
+    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 16);
+    vec3 specular = specularStrength * spec * lightColor;
+    
+    vec3 result = (ambient + diffuse + specular) * CubeColor;
+    
+    // Distance au bord de la face en pixels d'écran (dérivées de FaceUV),
+    // fondue sur un pixel pour un contour lissé
+    vec2 border = min(FaceUV, 1.0 - FaceUV) / fwidth(FaceUV);
+    float halfWidth = edgeWidth * 0.5;
+    float edge = 1.0 - smoothstep(halfWidth - 0.5, halfWidth + 0.5, min(border.x, border.y));
+    result = mix(result, CubeColor * 0.3, edge);
+    FragColor = vec4(result, 1.0);
+}
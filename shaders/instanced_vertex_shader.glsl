@@ -0,0 +1,29 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aFaceUV;
+// Par instance : position du cube et couleur
+layout (location = 3) in vec3 aOffset;
+layout (location = 4) in vec3 aColor;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 FaceUV;
+out vec3 CubeColor;
+
+void main() {
+    // Couleur négative (ResidentCubes::HIDDEN) : cellule vide, rejetée par le clipping
+    if (aColor.r < 0.0) {
+        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+        return;
+    }
+    FragPos = aPos + aOffset;
+    Normal = aNormal;
+    FaceUV = aFaceUV;
+    CubeColor = aColor;
+    
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -1,11 +1,20 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aFaceUV;
 
-uniform vec3 cubePosition;
-uniform mat4 projection;
+uniform mat4 model;
 uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 FaceUV;
 
 void main() {
-    vec3 worldPos = aPos + cubePosition;
-    gl_Position = projection * view * vec4(worldPos, 1.0);
-}
\ No newline at end of file
+    FragPos = vec3(model * vec4(aPos, 1.0));
+    Normal = mat3(transpose(inverse(model))) * aNormal;
+    FaceUV = aFaceUV;
+    
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -0,0 +1,105 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 WorldPos;
+
+// Cellules du puits : 0 = vide, sinon type de pièce + 1
+uniform usampler2D cells;
+uniform vec3 palette[6];
+// Largeur, hauteur du puits et taille d'un pixel à distance 1 de la caméra
+uniform vec3 grid;
+uniform vec3 eyePos;
+uniform mat4 view;
+uniform mat4 projection;
+
+// Mêmes paramètres d'éclairage que les cubes
+uniform vec3 lightPos;
+uniform vec3 lightColor;
+uniform vec3 viewPos;
+
+vec3 shade(vec3 position, vec3 normal, vec3 color) {
+    float ambientStrength = 0.4;
+    vec3 ambient = ambientStrength * lightColor;
+    
+    vec3 lightDir = normalize(lightPos - position);
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = diff * lightColor;
+    
+    float specularStrength = 0.1;
+    vec3 viewDir = normalize(viewPos - position);
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 16);
+    vec3 specular = specularStrength * spec * lightColor;
+    
+    return (ambient + diffuse + specular) * color;
+}
+
+void main() {
+    // Faces arrière : le rayon est déjà traité par la face avant
+    if (!gl_FrontFacing) discard;
+
+    vec3 dir = normalize(WorldPos - eyePos);
+    // Évite les divisions par zéro des rayons parallèles à un axe
+    dir = mix(dir, vec3(1e-6), equal(dir, vec3(0.0)));
+    vec3 inv = 1.0 / dir;
+
+    vec3 boxMin = vec3(-0.5);
+    vec3 boxMax = vec3(grid.x - 0.5, grid.y - 0.5, 0.5);
+    vec3 t0 = (boxMin - eyePos) * inv;
+    vec3 t1 = (boxMax - eyePos) * inv;
+    vec3 tNear = min(t0, t1);
+    vec3 tFar = max(t0, t1);
+    float tEnter = max(max(tNear.x, tNear.y), tNear.z);
+    float tExit = min(min(tFar.x, tFar.y), tFar.z);
+
+    // Normale de la face d'entrée dans la boîte
+    vec3 normal;
+    if (tEnter == tNear.x) normal = vec3(-sign(dir.x), 0.0, 0.0);
+    else if (tEnter == tNear.y) normal = vec3(0.0, -sign(dir.y), 0.0);
+    else normal = vec3(0.0, 0.0, -sign(dir.z));
+    tEnter = max(tEnter, 0.0);
+
+    // Parcours DDA des cellules traversées, dans le plan du puits
+    ivec2 size = ivec2(grid.xy);
+    vec3 entry = eyePos + dir * (tEnter + 1e-4);
+    ivec2 cell = clamp(ivec2(floor(entry.xy + 0.5)), ivec2(0), size - 1);
+    ivec2 stepDir = ivec2(sign(dir.xy));
+    vec2 tDelta = abs(inv.xy);
+    vec2 tMax = (vec2(cell) + 0.5 * vec2(stepDir) - eyePos.xy) * inv.xy;
+    float tHit = tEnter;
+
+    int maxSteps = size.x + size.y + 2;
+    for (int i = 0; i < maxSteps; i++) {
+        uint value = texelFetch(cells, cell, 0).r;
+        if (value != 0u) {
+            vec3 position = eyePos + dir * tHit;
+            vec3 color = palette[int(value) - 1];
+
+            // Distance au bord le plus proche dans la face touchée : contour
+            // d'environ un pixel de chaque côté de l'arête, comme GL_LINES
+            vec3 local = position - vec3(vec2(cell), 0.0);
+            vec2 face = normal.x != 0.0 ? local.yz : (normal.y != 0.0 ? local.xz : local.xy);
+            float edgeDistance = 0.5 - max(abs(face.x), abs(face.y));
+            vec3 result = edgeDistance < grid.z * tHit ? color * 0.3 : shade(position, normal, color);
+
+            vec4 clip = projection * view * vec4(position, 1.0);
+            gl_FragDepth = clip.z / clip.w * 0.5 + 0.5;
+            FragColor = vec4(result, 1.0);
+            return;
+        }
+
+        if (tMax.x < tMax.y) {
+            tHit = tMax.x;
+            tMax.x += tDelta.x;
+            cell.x += stepDir.x;
+            normal = vec3(-float(stepDir.x), 0.0, 0.0);
+        } else {
+            tHit = tMax.y;
+            tMax.y += tDelta.y;
+            cell.y += stepDir.y;
+            normal = vec3(0.0, -float(stepDir.y), 0.0);
+        }
+        if (tHit > tExit || any(lessThan(cell, ivec2(0))) || any(greaterThanEqual(cell, size))) break;
+    }
+    discard;
+}
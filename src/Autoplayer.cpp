@@ -0,0 +1,282 @@
+#include "Autoplayer.h"
+#include "NeuralEvaluator.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+
+struct ShapeTable {
+    glm::ivec2 blocks[Simulation::PIECE_COUNT][4][4];
+
+    ShapeTable() {
+        // Les formes viennent de Piece pour rester identiques au jeu
+        for (int type = 0; type < Simulation::PIECE_COUNT; type++) {
+            Piece piece(static_cast<PieceType>(type), 0.0f, 0.0f);
+            for (int rotation = 0; rotation < 4; rotation++) {
+                std::vector<glm::vec2> positions = piece.getBlockPositions();
+                for (int i = 0; i < 4; i++) {
+                    blocks[type][rotation][i] = glm::ivec2(positions[i]);
+                }
+                piece.rotate();
+            }
+        }
+    }
+};
+
+const glm::ivec2* shapeBlocks(PieceType type, int rotation) {
+    static const ShapeTable table;
+    return table.blocks[static_cast<int>(type)][rotation & 3];
+}
+
+bool fits(const uint8_t* cells, int width, int height, const glm::ivec2* blocks, int x, int y) {
+    for (int i = 0; i < 4; i++) {
+        int bx = x + blocks[i].x;
+        int by = y + blocks[i].y;
+        if (bx < 0 || bx >= width || by < 0) return false;
+        if (by < height && cells[by * width + bx] != 0) return false;
+    }
+    return true;
+}
+
+}
+
+Autoplayer::Weights Autoplayer::defaultWeights() {
+    Weights w;
+    w[AGGREGATE_HEIGHT] = -0.51f;
+    w[COMPLETE_LINES] = 0.76f;
+    w[HOLES] = -0.36f;
+    w[BUMPINESS] = -0.18f;
+    w[MAX_HEIGHT] = 0.0f;
+    return w;
+}
+
+Autoplayer::Autoplayer(const Weights& weights, int depth)
+    : weights(weights), depth(depth), transpositionTable(nullptr), neuralEvaluator(nullptr),
+      weightsSalt(TranspositionTable::hashParameters(weights.data(), FEATURE_COUNT, 0)) {}
+
+bool Autoplayer::landingBlocks(const uint8_t* cells, int width, int height, PieceType type,
+                               int rotation, int x, glm::ivec2 blocks[4]) {
+    const glm::ivec2* shape = shapeBlocks(type, rotation);
+
+    // Même point d'apparition que Simulation::spawnNewPiece
+    int y = height;
+    if (!fits(cells, width, height, shape, x, y)) return false;
+    while (fits(cells, width, height, shape, x, y - 1)) y--;
+
+    for (int i = 0; i < 4; i++) {
+        blocks[i] = glm::ivec2(x, y) + shape[i];
+        // Un bloc posé au-dessus du puits serait perdu : on refuse ce placement
+        if (blocks[i].y >= height) return false;
+    }
+    return true;
+}
+
+int Autoplayer::dropPiece(uint8_t* cells, int width, int height, PieceType type,
+                          int rotation, int x) {
+    glm::ivec2 blocks[4];
+    if (!landingBlocks(cells, width, height, type, rotation, x, blocks)) return -1;
+    for (int i = 0; i < 4; i++) {
+        cells[blocks[i].y * width + blocks[i].x] = static_cast<uint8_t>(type) + 1;
+    }
+
+    int cleared = 0;
+    int writeRow = 0;
+    for (int row = 0; row < height; row++) {
+        const uint8_t* line = cells + row * width;
+        bool full = std::find(line, line + width, 0) == line + width;
+        if (full) {
+            cleared++;
+            continue;
+        }
+        if (writeRow != row) std::copy(line, line + width, cells + writeRow * width);
+        writeRow++;
+    }
+    std::fill(cells + writeRow * width, cells + height * width, 0);
+    return cleared;
+}
+
+void Autoplayer::computeFeatures(const uint8_t* cells, int width, int height, int linesCleared,
+                                 float features[FEATURE_COUNT]) {
+    int aggregateHeight = 0;
+    int holes = 0;
+    int bumpiness = 0;
+    int maxHeight = 0;
+    int previousHeight = 0;
+
+    for (int x = 0; x < width; x++) {
+        int columnHeight = 0;
+        for (int y = height - 1; y >= 0; y--) {
+            if (cells[y * width + x] != 0) {
+                columnHeight = y + 1;
+                break;
+            }
+        }
+        for (int y = 0; y < columnHeight; y++) {
+            if (cells[y * width + x] == 0) holes++;
+        }
+        aggregateHeight += columnHeight;
+        maxHeight = std::max(maxHeight, columnHeight);
+        if (x > 0) bumpiness += std::abs(columnHeight - previousHeight);
+        previousHeight = columnHeight;
+    }
+
+    features[AGGREGATE_HEIGHT] = static_cast<float>(aggregateHeight);
+    features[COMPLETE_LINES] = static_cast<float>(linesCleared);
+    features[HOLES] = static_cast<float>(holes);
+    features[BUMPINESS] = static_cast<float>(bumpiness);
+    features[MAX_HEIGHT] = static_cast<float>(maxHeight);
+}
+
+float Autoplayer::evaluate(const uint8_t* cells, int width, int height, int linesCleared) const {
+    float features[FEATURE_COUNT];
+    computeFeatures(cells, width, height, linesCleared, features);
+    float score = 0.0f;
+    for (int i = 0; i < FEATURE_COUNT; i++) score += weights[i] * features[i];
+    return score;
+}
+
+// Le terme des lignes étant linéaire, la valeur d'un noeud ne dépend que du
+// plateau et des pièces restantes : les lignes effacées plus haut dans l'arbre
+// sont ajoutées par l'appelant, ce qui rend les noeuds partageables.
+float Autoplayer::searchBest(const uint8_t* cells, int width, int height, const PieceType* pieces,
+                             int pieceCount, std::vector<uint8_t>* scratch, Placement* best) const {
+    uint64_t key = 0;
+    if (transpositionTable && !best) {
+        float cached;
+        key = TranspositionTable::hashPosition(cells, width, height, pieces, pieceCount) ^ weightsSalt;
+        if (neuralEvaluator) key ^= neuralEvaluator->getFingerprint();
+        if (transpositionTable->probe(key, pieceCount, cached)) return cached;
+    }
+
+    if (pieceCount == 1 && neuralEvaluator && neuralEvaluator->accepts(width, height)) {
+        float score = searchLeafBatched(cells, width, height, pieces[0], scratch[0], best);
+        if (transpositionTable && !best) transpositionTable->store(key, pieceCount, score);
+        return score;
+    }
+
+    float bestScore = -std::numeric_limits<float>::infinity();
+    std::vector<uint8_t>& board = scratch[0];
+
+    for (int rotation = 0; rotation < 4; rotation++) {
+        for (int x = 0; x < width; x++) {
+            board.assign(cells, cells + width * height);
+            int lines = dropPiece(board.data(), width, height, pieces[0], rotation, x);
+            if (lines < 0) continue;
+
+            float score;
+            if (pieceCount > 1) {
+                score = searchBest(board.data(), width, height, pieces + 1, pieceCount - 1,
+                                   scratch + 1, nullptr);
+                // Aucun placement possible pour la pièce suivante : on évalue quand même ce plateau
+                if (score == -std::numeric_limits<float>::infinity()) {
+                    score = evaluate(board.data(), width, height, 0);
+                }
+                score += weights[COMPLETE_LINES] * lines;
+            } else {
+                score = evaluate(board.data(), width, height, lines);
+            }
+
+            if (score > bestScore) {
+                bestScore = score;
+                if (best) {
+                    best->rotation = rotation;
+                    best->x = x;
+                    best->score = score;
+                    best->valid = true;
+                }
+            }
+        }
+    }
+
+    if (transpositionTable && !best) transpositionTable->store(key, pieceCount, bestScore);
+    return bestScore;
+}
+
+// Toutes les positions candidates d'une même pièce sont évaluées par lots
+float Autoplayer::searchLeafBatched(const uint8_t* cells, int width, int height, PieceType piece,
+                                    std::vector<uint8_t>& batch, Placement* best) const {
+    const int cellCount = width * height;
+    batch.resize(static_cast<size_t>(NeuralEvaluator::MAX_BATCH) * cellCount);
+
+    float bestScore = -std::numeric_limits<float>::infinity();
+    int lines[NeuralEvaluator::MAX_BATCH];
+    int rotations[NeuralEvaluator::MAX_BATCH];
+    int columns[NeuralEvaluator::MAX_BATCH];
+    float scores[NeuralEvaluator::MAX_BATCH];
+    int count = 0;
+
+    auto flush = [&]() {
+        neuralEvaluator->evaluateBatch(batch.data(), count, scores);
+        for (int i = 0; i < count; i++) {
+            float score = scores[i] + weights[COMPLETE_LINES] * lines[i];
+            if (score > bestScore) {
+                bestScore = score;
+                if (best) {
+                    best->rotation = rotations[i];
+                    best->x = columns[i];
+                    best->score = score;
+                    best->valid = true;
+                }
+            }
+        }
+        count = 0;
+    };
+
+    for (int rotation = 0; rotation < 4; rotation++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* board = batch.data() + static_cast<size_t>(count) * cellCount;
+            std::copy(cells, cells + cellCount, board);
+            int cleared = dropPiece(board, width, height, piece, rotation, x);
+            if (cleared < 0) continue;
+
+            lines[count] = cleared;
+            rotations[count] = rotation;
+            columns[count] = x;
+            if (++count == NeuralEvaluator::MAX_BATCH) flush();
+        }
+    }
+    if (count > 0) flush();
+    return bestScore;
+}
+
+Autoplayer::Placement Autoplayer::findBestPlacement(const Simulation& simulation) const {
+    PROFILE_ZONE("Autoplayer::findBestPlacement");
+    Placement best;
+    const Piece* piece = simulation.getCurrentPiece();
+    if (!piece || simulation.getGameState() != GameState::PLAYING) return best;
+
+    int pieceCount = std::max(1, std::min(depth, Simulation::QUEUE_SIZE + 1));
+    PieceType pieces[Simulation::QUEUE_SIZE + 1];
+    pieces[0] = piece->getType();
+    for (int i = 1; i < pieceCount; i++) pieces[i] = simulation.getQueuedPiece(i - 1);
+
+    std::vector<uint8_t> scratch[Simulation::QUEUE_SIZE + 1];
+    searchBest(simulation.getCells(), simulation.getWidth(), simulation.getHeight(),
+               pieces, pieceCount, scratch, &best);
+    return best;
+}
+
+void Autoplayer::applyPlacement(Simulation& simulation, const Placement& placement) const {
+    if (placement.valid) {
+        for (int i = 0; i < placement.rotation; i++) simulation.rotateCurrentPiece();
+
+        const Piece* piece = simulation.getCurrentPiece();
+        if (piece) {
+            int dx = placement.x - static_cast<int>(piece->getX());
+            int direction = dx > 0 ? 1 : -1;
+            for (int i = 0; i < std::abs(dx); i++) simulation.moveCurrentPiece(direction, 0);
+        }
+    }
+    simulation.hardDrop();
+}
+
+int Autoplayer::playGame(Simulation& simulation, int maxPieces) const {
+    int pieces = 0;
+    while (simulation.getGameState() == GameState::PLAYING && pieces < maxPieces) {
+        applyPlacement(simulation, findBestPlacement(simulation));
+        pieces++;
+    }
+    return pieces;
+}
\ No newline at end of file
@@ -1,222 +1,227 @@
 #include "Board.h"
+#include "GlStats.h"
+#include "Profiler.h"
+#include "RenderBackend.h"
+#include "StartupReport.h"
+#include "VoxelField.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <glm/gtc/matrix_transform.hpp>
 #include <ctime>
 
-Board::Board() : gameState(GameState::WAITING_TO_START), currentPiece(nullptr), 
-                 score(0), linesCleared(0), rng(std::time(0)), pieceDist(0, 5) {
-    field.resize(FIELD_HEIGHT);
-    for (int y = 0; y < FIELD_HEIGHT; y++) {
-        field[y].resize(FIELD_WIDTH, nullptr);
-    }
+Board::Board(int width, int height) : fieldWidth(width), fieldHeight(height),
+                 hintVisible(false), autoplay(false), voxelField(nullptr), resolution(nullptr), perfOverlayVisible(false),
+                 frameMs(0.0f), revision(0), simulation(width, height, std::time(0)),
+                 viewportWidth(LAYOUT_WIDTH), viewportHeight(LAYOUT_HEIGHT) {
+    syncedCells.assign(static_cast<size_t>(fieldWidth) * fieldHeight, 0);
+    filledRows.assign(fieldHeight, false);
     
     initializeWalls();
+    pieceCubes = new CubeInstances();
+    StartupReport::mark("Board : murs et cubes");
     
     textRenderer = new TextRenderer();
-    textRenderer->setProjection(1200, 900);
+    StartupReport::mark("Board : TextRenderer");
+    
+    gpuTimer = new GpuTimer();
+    gpuTimer->setEnabled(false);
+    perfOverlay = new PerfOverlay();
     
+    // Caméra centrée sur le puits, reculée pour les puits plus grands que 10x20
+    float centerX = (fieldWidth - 1) * 0.5f;
+    float centerY = fieldHeight * 0.5f;
+    cameraDistance = 30.0f * std::max(1.0f, std::max(fieldWidth / 10.0f, fieldHeight / 20.0f));
     view = glm::lookAt(
-        glm::vec3(4.5f, 10.0f, 30.0f),
-        glm::vec3(4.5f, 10.0f, 0.0f),
+        glm::vec3(centerX, centerY, cameraDistance),
+        glm::vec3(centerX, centerY, 0.0f),
         glm::vec3(0.0f, 1.0f, 0.0f)
     );
-    
-    projection = glm::perspective(
-        glm::radians(45.0f),
-        1200.0f / 900.0f, 
-        0.1f, 
-        100.0f
-    );
+    setViewportSize(viewportWidth, viewportHeight);
 }
 
 Board::~Board() {
-    clearField();
-    for (Cube* wall : walls) delete wall;
-    for (Cube* tile : floorTiles) delete tile;
-    delete currentPiece;
+    delete sceneCubes;
+    delete pieceCubes;
     delete textRenderer;
-}
-
-void Board::clearField() {
-    for (int y = 0; y < FIELD_HEIGHT; y++) {
-        for (int x = 0; x < FIELD_WIDTH; x++) {
-            delete field[y][x];
-            field[y][x] = nullptr;
-        }
-    }
+    delete gpuTimer;
+    delete perfOverlay;
+    delete voxelField;
+    delete resolution;
 }
 
 void Board::initializeWalls() {
     glm::vec3 frameColor(0.6f, 0.6f, 0.65f);
+    std::vector<CubeInstance> walls;
     
-    for (int x = -1; x <= FIELD_WIDTH; x++) {
-        walls.push_back(new Cube(x, -1, 0, frameColor));
+    for (int x = -1; x <= fieldWidth; x++) {
+        walls.push_back(CubeInstance{glm::vec3(x, -1, 0), frameColor});
     }
     
-    for (int y = 0; y <= FIELD_HEIGHT; y++) {
-        walls.push_back(new Cube(-1, y, 0, frameColor));
+    for (int y = 0; y <= fieldHeight; y++) {
+        walls.push_back(CubeInstance{glm::vec3(-1, y, 0), frameColor});
     }
     
-    for (int y = 0; y <= FIELD_HEIGHT; y++) {
-        walls.push_back(new Cube(FIELD_WIDTH, y, 0, frameColor));
+    for (int y = 0; y <= fieldHeight; y++) {
+        walls.push_back(CubeInstance{glm::vec3(fieldWidth, y, 0), frameColor});
     }
+    
+    // Les murs ne bougent jamais : envoyés une fois, avec une cellule par case du puits
+    int wallCount = static_cast<int>(walls.size());
+    sceneCubes = new ResidentCubes({wallCount, fieldWidth * fieldHeight});
+    sceneCubes->write(WALL_RANGE, 0, walls.data(), wallCount);
+    sceneCubes->setDrawCount(WALL_RANGE, wallCount);
 }
 
 void Board::initializeFloor() {}
 
 void Board::startGame() {
-    if (gameState != GameState::WAITING_TO_START) return;
-    resetGame();
-    gameState = GameState::PLAYING;
-    spawnNewPiece();
+    if (simulation.getGameState() != GameState::WAITING_TO_START) return;
+    simulation.reset();
+    simulation.start();
+    revision++;
 }
 
 void Board::resetGame() {
-    clearField();
-    delete currentPiece;
-    currentPiece = nullptr;
-    score = 0;
-    linesCleared = 0;
-    gameState = GameState::WAITING_TO_START;
-}
-
-void Board::spawnNewPiece() {
-    if (gameState != GameState::PLAYING) return;
-    PieceType type = static_cast<PieceType>(pieceDist(rng));
-    currentPiece = new Piece(type, 5.0f, FIELD_HEIGHT);
-    
-    if (!isValidPosition(currentPiece->getBlockPositions())) {
-        gameState = GameState::GAME_OVER;
-        delete currentPiece;
-        currentPiece = nullptr;
-    }
-}
-
-bool Board::isValidPosition(const std::vector<glm::vec2>& positions) {
-    for (const glm::vec2& pos : positions) {
-        int x = static_cast<int>(pos.x);
-        int y = static_cast<int>(pos.y);
-        if (x < 0 || x >= FIELD_WIDTH || y < 0) return false;
-        if (y < FIELD_HEIGHT && field[y][x] != nullptr) return false;
-    }
-    return true;
+    simulation.reset();
+    revision++;
 }
 
 void Board::moveCurrentPiece(int dx, int dy) {
-    if (!currentPiece || gameState != GameState::PLAYING) return;
-    currentPiece->move(dx, dy);
-    if (!isValidPosition(currentPiece->getBlockPositions())) {
-        currentPiece->move(-dx, -dy);
-    }
+    simulation.moveCurrentPiece(dx, dy);
+    revision++;
 }
 
 void Board::rotateCurrentPiece() {
-    if (!currentPiece || gameState != GameState::PLAYING) return;
-    
-    std::vector<glm::vec2> oldPositions = currentPiece->getBlockPositions();
-    
-    currentPiece->rotate();
-    
-    if (!isValidPosition(currentPiece->getBlockPositions())) {
-        currentPiece->move(1, 0);
-        if (!isValidPosition(currentPiece->getBlockPositions())) {
-            currentPiece->move(-2, 0);
-            if (!isValidPosition(currentPiece->getBlockPositions())) {
-                currentPiece->move(1, 1);
-                if (!isValidPosition(currentPiece->getBlockPositions())) {
-                    currentPiece->move(0, -1);
-                    currentPiece->rotate();
-                    currentPiece->rotate();
-                    currentPiece->rotate();
-                }
-            }
-        }
-    }
+    simulation.rotateCurrentPiece();
+    revision++;
 }
 
 void Board::dropCurrentPiece() {
-    if (!currentPiece || gameState != GameState::PLAYING) return;
-    
-    currentPiece->move(0, -1);
-    if (!isValidPosition(currentPiece->getBlockPositions())) {
-        currentPiece->move(0, 1);
-        lockCurrentPiece();
-    }
+    simulation.update();
+    revision++;
 }
 
 void Board::update() {
-    if (!currentPiece || gameState != GameState::PLAYING) return;
-    currentPiece->move(0, -1);
-    if (!isValidPosition(currentPiece->getBlockPositions())) {
-        currentPiece->move(0, 1);
-        lockCurrentPiece();
-    }
+    simulation.update();
+    revision++;
 }
 
-void Board::lockCurrentPiece() {
-    if (!currentPiece) return;
-    
-    std::vector<glm::vec2> positions = currentPiece->getBlockPositions();
-    glm::vec3 color = currentPiece->getColor();
-    
-    for (const glm::vec2& pos : positions) {
-        int x = static_cast<int>(pos.x);
-        int y = static_cast<int>(pos.y);
-        if (x >= 0 && x < FIELD_WIDTH && y >= 0 && y < FIELD_HEIGHT) {
-            field[y][x] = new Cube(x, y, 0, color);
-        }
+void Board::setHint(const Autoplayer::Placement* placement) {
+    bool visible = placement != nullptr && placement->valid;
+    // Appelé à chaque image : seul un vrai changement de fantôme compte
+    if (visible != hintVisible || (visible && (placement->x != hint.x || placement->rotation != hint.rotation))) {
+        revision++;
     }
-    
-    delete currentPiece;
-    currentPiece = nullptr;
-    checkAndClearLines();
-    spawnNewPiece();
+    hintVisible = visible;
+    if (hintVisible) hint = *placement;
 }
 
-void Board::checkAndClearLines() {
-    int clearedThisTurn = 0;
-    for (int y = 0; y < FIELD_HEIGHT; y++) {
-        if (isLineFull(y)) {
-            clearLine(y);
-            dropLinesAbove(y);
-            clearedThisTurn++;
-            y--;
-        }
-    }
-    if (clearedThisTurn > 0) {
-        linesCleared += clearedThisTurn;
-        score += clearedThisTurn * 100 * (clearedThisTurn > 1 ? 2 : 1);
+void Board::setVoxelField(bool enabled) {
+    if (enabled == isVoxelField()) return;
+    if (enabled) {
+        // La plage de la pile n'est plus dessinée ; elle reste à jour au retour
+        sceneCubes->setDrawCount(STACK_RANGE, 0);
+        voxelField = new VoxelField(fieldWidth, fieldHeight);
+    } else {
+        delete voxelField;
+        voxelField = nullptr;
     }
+    revision++;
 }
 
-bool Board::isLineFull(int line) {
-    for (int x = 0; x < FIELD_WIDTH; x++) {
-        if (field[line][x] == nullptr) return false;
-    }
-    return true;
+void Board::setDynamicResolution(const DynamicResolution::Options& options) {
+    delete resolution;
+    resolution = options.budgetMs > 0.0f ? new DynamicResolution(options) : nullptr;
+    revision++;
+}
+
+void Board::setViewportSize(int width, int height) {
+    // Fenêtre réduite : framebuffer vide, on garde le format précédent
+    if (width <= 0 || height <= 0) return;
+    viewportWidth = width;
+    viewportHeight = height;
+    projection = glm::perspective(
+        glm::radians(45.0f),
+        static_cast<float>(width) / height,
+        0.1f,
+        std::max(100.0f, cameraDistance + 10.0f)
+    );
+    textRenderer->fitLayout(width, height, LAYOUT_WIDTH, LAYOUT_HEIGHT);
+    revision++;
+}
+
+void Board::setPerfOverlay(bool visible) {
+    perfOverlayVisible = visible;
+    revision++;
+    gpuTimer->setEnabled(visible);
 }
 
-void Board::clearLine(int line) {
-    for (int x = 0; x < FIELD_WIDTH; x++) {
-        delete field[line][x];
-        field[line][x] = nullptr;
+void Board::setTableStats(const TranspositionTable::Stats& stats) {
+    perfOverlay->setTableStats(static_cast<float>(stats.hitRate()), static_cast<float>(stats.occupancy()));
+}
+
+// Fantôme puis pièce, dessinés après la pile
+void Board::collectPieceInstances() {
+    pieceInstances.clear();
+    const Piece* currentPiece = simulation.getCurrentPiece();
+    if (!currentPiece || simulation.getGameState() != GameState::PLAYING) return;
+    
+    glm::ivec2 blocks[4];
+    if (hintVisible && Autoplayer::landingBlocks(simulation.getCells(), fieldWidth, fieldHeight,
+                                                 currentPiece->getType(), hint.rotation, hint.x, blocks)) {
+        // Couleur de la pièce éclaircie pour le fantôme
+        glm::vec3 color = glm::mix(currentPiece->getColor(), glm::vec3(1.0f), 0.6f);
+        for (int i = 0; i < 4; i++) pieceInstances.push_back(CubeInstance{glm::vec3(blocks[i], 0.0f), color});
+    }
+    
+    for (const glm::vec2& block : currentPiece->getBlockPositions()) {
+        pieceInstances.push_back(CubeInstance{glm::vec3(block, 0.0f), currentPiece->getColor()});
     }
 }
 
-void Board::dropLinesAbove(int clearedLine) {
-    for (int y = clearedLine + 1; y < FIELD_HEIGHT; y++) {
-        for (int x = 0; x < FIELD_WIDTH; x++) {
-            if (field[y][x] != nullptr) {
-                field[y-1][x] = field[y][x];
-                field[y-1][x]->setPosition(x, y-1, 0);
-                field[y][x] = nullptr;
+// Renvoie au GPU les lignes de la pile modifiées depuis l'image précédente,
+// regroupées en plages contiguës ; seules les lignes jusqu'à la plus haute
+// ligne non vide sont dessinées
+void Board::syncField() {
+    const uint8_t* cells = simulation.getCells();
+    for (int y = 0; y < fieldHeight; ) {
+        size_t offset = static_cast<size_t>(y) * fieldWidth;
+        if (std::memcmp(cells + offset, syncedCells.data() + offset, fieldWidth) == 0) {
+            y++;
+            continue;
+        }
+        int first = y;
+        rowInstances.clear();
+        for (; y < fieldHeight; y++) {
+            offset = static_cast<size_t>(y) * fieldWidth;
+            if (std::memcmp(cells + offset, syncedCells.data() + offset, fieldWidth) == 0) break;
+            std::memcpy(syncedCells.data() + offset, cells + offset, fieldWidth);
+            filledRows[y] = false;
+            for (int x = 0; x < fieldWidth; x++) {
+                uint8_t cell = cells[offset + x];
+                glm::vec3 color = ResidentCubes::HIDDEN;
+                if (cell != 0) {
+                    color = Piece::colorFor(static_cast<PieceType>(cell - 1));
+                    filledRows[y] = true;
+                }
+                rowInstances.push_back(CubeInstance{glm::vec3(x, y, 0), color});
             }
         }
+        sceneCubes->write(STACK_RANGE, first * fieldWidth, rowInstances.data(), static_cast<int>(rowInstances.size()));
     }
+    
+    int rows = fieldHeight;
+    while (rows > 0 && !filledRows[rows - 1]) rows--;
+    sceneCubes->setDrawCount(STACK_RANGE, rows * fieldWidth);
 }
 
 void Board::renderInstructions() {
-    glDisable(GL_DEPTH_TEST);
+    GameState gameState = simulation.getGameState();
+    
+    RenderBackend::current().setDepthTest(false);
     
     glm::vec3 titleColor(0.85f, 0.45f, 0.55f);
     glm::vec3 subtitleColor(0.55f, 0.45f, 0.65f);
@@ -226,89 +231,154 @@ void Board::renderInstructions() {
     glm::vec3 accentColor(0.95f, 0.7f, 0.5f);
     glm::vec3 dimColor(0.65f, 0.65f, 0.7f);
     
-    textRenderer->renderText("TETRIS 3D", 460, 850, 5.0f, titleColor);
+    textRenderer->queueText("TETRIS 3D", 460, 850, 5.0f, titleColor);
     
     float leftX = 50.0f;
     
     if (gameState == GameState::WAITING_TO_START) {
-        textRenderer->renderText("PRESS", leftX, 500, 3.5f, titleColor);
-        textRenderer->renderText("SPACE", leftX, 460, 3.5f, titleColor);
-        textRenderer->renderText("TO", leftX + 30, 420, 3.0f, dimColor);
-        textRenderer->renderText("START!", leftX, 380, 3.5f, titleColor);
+        textRenderer->queueText("PRESS", leftX, 500, 3.5f, titleColor);
+        textRenderer->queueText("SPACE", leftX, 460, 3.5f, titleColor);
+        textRenderer->queueText("TO", leftX + 30, 420, 3.0f, dimColor);
+        textRenderer->queueText("START!", leftX, 380, 3.5f, titleColor);
     } else if (gameState == GameState::GAME_OVER) {
-        textRenderer->renderText("GAME", leftX, 500, 4.0f, glm::vec3(0.9f, 0.3f, 0.4f));
-        textRenderer->renderText("OVER", leftX, 450, 4.0f, glm::vec3(0.9f, 0.3f, 0.4f));
-        textRenderer->renderText("------", leftX, 420, 2.5f, glm::vec3(0.9f, 0.3f, 0.4f));
-        textRenderer->renderText("SPACE", leftX, 370, 2.8f, keyColor);
-        textRenderer->renderText("to", leftX + 25, 330, 2.5f, dimColor);
-        textRenderer->renderText("retry", leftX + 10, 290, 2.8f, textColor);
+        textRenderer->queueText("GAME", leftX, 500, 4.0f, glm::vec3(0.9f, 0.3f, 0.4f));
+        textRenderer->queueText("OVER", leftX, 450, 4.0f, glm::vec3(0.9f, 0.3f, 0.4f));
+        textRenderer->queueText("------", leftX, 420, 2.5f, glm::vec3(0.9f, 0.3f, 0.4f));
+        textRenderer->queueText("SPACE", leftX, 370, 2.8f, keyColor);
+        textRenderer->queueText("to", leftX + 25, 330, 2.5f, dimColor);
+        textRenderer->queueText("retry", leftX + 10, 290, 2.8f, textColor);
     } else if (gameState == GameState::PLAYING) {
-        textRenderer->renderText("STATUS", leftX, 500, 2.5f, dimColor);
-        textRenderer->renderText("PLAYING", leftX, 460, 3.0f, scoreColor);
+        textRenderer->queueText("STATUS", leftX, 500, 2.5f, dimColor);
+        textRenderer->queueText("PLAYING", leftX, 460, 3.0f, scoreColor);
+        if (autoplay) textRenderer->queueText("AUTO", leftX, 420, 3.0f, accentColor);
     }
     
     float rightX = 850.0f;
     
-    textRenderer->renderText("SCORE", rightX, 780, 3.5f, subtitleColor);
-    textRenderer->renderText("--------", rightX, 750, 2.5f, dimColor);
+    textRenderer->queueText("SCORE", rightX, 780, 3.5f, subtitleColor);
+    textRenderer->queueText("--------", rightX, 750, 2.5f, dimColor);
         
     // Score avec des zéros devant 
-    std::string scoreStr = std::to_string(score);
+    std::string scoreStr = std::to_string(simulation.getScore());
     while (scoreStr.length() < 6) scoreStr = "0" + scoreStr;
-    textRenderer->renderText(scoreStr, rightX, 700, 4.0f, scoreColor);
+    textRenderer->queueText(scoreStr, rightX, 700, 4.0f, scoreColor);
     
-    textRenderer->renderText("LINES", rightX, 620, 3.5f, subtitleColor);
-    textRenderer->renderText(std::to_string(linesCleared), rightX, 570, 4.0f, accentColor);
+    textRenderer->queueText("LINES", rightX, 620, 3.5f, subtitleColor);
+    textRenderer->queueText(std::to_string(simulation.getLinesCleared()), rightX, 570, 4.0f, accentColor);
     
-    textRenderer->renderText("CONTROLS", rightX, 490, 3.0f, subtitleColor);
-    textRenderer->renderText("----------", rightX, 465, 2.5f, dimColor);
+    textRenderer->queueText("CONTROLS", rightX, 490, 3.0f, subtitleColor);
+    textRenderer->queueText("----------", rightX, 465, 2.5f, dimColor);
     
     float ctrlY = 420.0f;
     float spacing = 60.0f;
     float scale = 2.5f;
     
-    textRenderer->renderText("[A]", rightX, ctrlY, scale, keyColor);
-    textRenderer->renderText("or", rightX + 70, ctrlY, 2.0f, dimColor);
-    textRenderer->renderText("[<-]", rightX + 105, ctrlY, scale, keyColor);
-    textRenderer->renderText("Left", rightX, ctrlY - 30, scale, textColor);
+    textRenderer->queueText("[A]", rightX, ctrlY, scale, keyColor);
+    textRenderer->queueText("or", rightX + 70, ctrlY, 2.0f, dimColor);
+    textRenderer->queueText("[<-]", rightX + 105, ctrlY, scale, keyColor);
+    textRenderer->queueText("Left", rightX, ctrlY - 30, scale, textColor);
+    
+    textRenderer->queueText("[E]", rightX, ctrlY - spacing, scale, keyColor);
+    textRenderer->queueText("or", rightX + 70, ctrlY - spacing, 2.0f, dimColor);
+    textRenderer->queueText("[->]", rightX + 105, ctrlY - spacing, scale, keyColor);
+    textRenderer->queueText("Right", rightX, ctrlY - spacing - 30, scale, textColor);
     
-    textRenderer->renderText("[E]", rightX, ctrlY - spacing, scale, keyColor);
-    textRenderer->renderText("or", rightX + 70, ctrlY - spacing, 2.0f, dimColor);
-    textRenderer->renderText("[->]", rightX + 105, ctrlY - spacing, scale, keyColor);
-    textRenderer->renderText("Right", rightX, ctrlY - spacing - 30, scale, textColor);
+    textRenderer->queueText("[S]", rightX, ctrlY - spacing * 2, scale, keyColor);
+    textRenderer->queueText("or", rightX + 70, ctrlY - spacing * 2, 2.0f, dimColor);
+    textRenderer->queueText("[v]", rightX + 105, ctrlY - spacing * 2, scale, keyColor);
+    textRenderer->queueText("Down", rightX, ctrlY - spacing * 2 - 30, scale, textColor);
     
-    textRenderer->renderText("[S]", rightX, ctrlY - spacing * 2, scale, keyColor);
-    textRenderer->renderText("or", rightX + 70, ctrlY - spacing * 2, 2.0f, dimColor);
-    textRenderer->renderText("[v]", rightX + 105, ctrlY - spacing * 2, scale, keyColor);
-    textRenderer->renderText("Down", rightX, ctrlY - spacing * 2 - 30, scale, textColor);
+    textRenderer->queueText("[UP]", rightX, ctrlY - spacing * 3, scale, keyColor);
+    textRenderer->queueText("or", rightX + 80, ctrlY - spacing * 3, 2.0f, dimColor);
+    textRenderer->queueText("[W]", rightX + 115, ctrlY - spacing * 3, scale, keyColor);
+    textRenderer->queueText("Rotate", rightX, ctrlY - spacing * 3 - 30, scale, textColor);
     
-    textRenderer->renderText("[UP]", rightX, ctrlY - spacing * 3, scale, keyColor);
-    textRenderer->renderText("or", rightX + 80, ctrlY - spacing * 3, 2.0f, dimColor);
-    textRenderer->renderText("[W]", rightX + 115, ctrlY - spacing * 3, scale, keyColor);
-    textRenderer->renderText("Rotate", rightX, ctrlY - spacing * 3 - 30, scale, textColor);
+    textRenderer->queueText("[SPACE]", rightX, ctrlY - spacing * 4, scale, keyColor);
+    textRenderer->queueText("Play", rightX, ctrlY - spacing * 4 - 30, scale, textColor);
     
-    textRenderer->renderText("[SPACE]", rightX, ctrlY - spacing * 4, scale, keyColor);
-    textRenderer->renderText("Play", rightX, ctrlY - spacing * 4 - 30, scale, textColor);
+    textRenderer->queueText("[ESC]", rightX, ctrlY - spacing * 5, scale, keyColor);
+    textRenderer->queueText("Quit", rightX, ctrlY - spacing * 5 - 30, scale, textColor);
     
-    textRenderer->renderText("[ESC]", rightX, ctrlY - spacing * 5, scale, keyColor);
-    textRenderer->renderText("Quit", rightX, ctrlY - spacing * 5 - 30, scale, textColor);
+    textRenderer->queueText("[H]", rightX, ctrlY - spacing * 6, scale, keyColor);
+    textRenderer->queueText("Hint", rightX + 70, ctrlY - spacing * 6, scale, textColor);
+    textRenderer->queueText("[P]", rightX + 170, ctrlY - spacing * 6, scale, keyColor);
+    textRenderer->queueText("Auto", rightX + 240, ctrlY - spacing * 6, scale, textColor);
+    textRenderer->flush();
     
-    glEnable(GL_DEPTH_TEST);
+    RenderBackend::current().setDepthTest(true);
+}
+
+// Compteurs GL de l'image précédente, au-dessus du graphe des temps
+void Board::renderGlStats() {
+    const GlStats::Counters& counters = GlStats::lastFrame();
+    glm::vec3 labelColor(0.55f, 0.45f, 0.65f);
+    glm::vec3 valueColor(0.5f, 0.5f, 0.55f);
+    
+    const std::pair<const char*, unsigned long long> rows[] = {
+        {"draws", counters.drawCalls},
+        {"programs", counters.programBinds},
+        {"vaos", counters.vaoBinds},
+        {"uploads", counters.bufferUploads},
+        {"bytes", counters.bytesUploaded},
+        {"uniforms", counters.uniformUpdates},
+        {"lookups", counters.uniformLookups},
+        {"stalls", counters.streamStalls},
+    };
+    
+    float x = 20.0f;
+    // Entre le graphe des temps (jusqu'à y = 244) et le statut (y = 420)
+    float y = 250.0f;
+    float scale = 2.0f;
+    for (int i = static_cast<int>(std::size(rows)) - 1; i >= 0; i--) {
+        textRenderer->queueText(rows[i].first, x, y, scale, labelColor);
+        textRenderer->queueText(std::to_string(rows[i].second), x + 120.0f, y, scale, valueColor);
+        y += 18.0f;
+    }
+    textRenderer->queueText("GL / FRAME", x, y, scale, labelColor);
+    textRenderer->flush();
 }
 
 void Board::render() {
-    for (Cube* tile : floorTiles) tile->render(view, projection);
-    for (Cube* wall : walls) wall->render(view, projection);
+    auto cpuStart = std::chrono::steady_clock::now();
     
-    for (int y = 0; y < FIELD_HEIGHT; y++) {
-        for (int x = 0; x < FIELD_WIDTH; x++) {
-            if (field[y][x] != nullptr) field[y][x]->render(view, projection);
-        }
+    {
+        PROFILE_ZONE("Board::syncField");
+        if (voxelField) voxelField->update(simulation.getCells());
+        else syncField();
     }
-    
-    if (currentPiece && gameState == GameState::PLAYING) {
-        currentPiece->render(view, projection);
+    collectPieceInstances();
+    pieceCubes->upload(pieceInstances);
+    
+    // Faces et contours en une passe : les arêtes sont tracées par le fragment shader
+    gpuTimer->beginFrame();
+    if (resolution) resolution->beginScene(viewportWidth, viewportHeight);
+    gpuTimer->begin(GpuTimer::CUBES);
+    sceneCubes->render(view, projection, Cube::LIGHT_POSITION, Cube::VIEW_POSITION, Cube::EDGE_WIDTH);
+    pieceCubes->render(view, projection, Cube::LIGHT_POSITION, Cube::VIEW_POSITION, Cube::EDGE_WIDTH);
+    if (voxelField) voxelField->render(view, projection, resolution ? resolution->getSceneHeight() : viewportHeight);
+    gpuTimer->end();
+    if (resolution) resolution->endScene();
+    
+    {
+        PROFILE_ZONE("Board::renderInstructions");
+        gpuTimer->begin(GpuTimer::HUD);
+        renderInstructions();
+        gpuTimer->end();
+    }
+    gpuTimer->endFrame();
+    
+    if (perfOverlayVisible) {
+        float cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - cpuStart).count();
+        perfOverlay->addSample(frameMs, cpuMs, *gpuTimer);
+        perfOverlay->setResolutionScale(resolution ? resolution->getScale() : 0.0f);
+        RenderBackend::current().setDepthTest(false);
+        perfOverlay->render(*textRenderer, 20.0f, 20.0f);
+        RenderBackend::current().setDepthTest(true);
     }
     
-    renderInstructions();
+    if (GlStats::isEnabled()) {
+        RenderBackend::current().setDepthTest(false);
+        renderGlStats();
+        RenderBackend::current().setDepthTest(true);
+    }
 }
\ No newline at end of file
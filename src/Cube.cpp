@@ -1,36 +1,40 @@
 #include "Cube.h"
+#include "RenderBackend.h"
+#include "ShaderRegistry.h"
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
 const float Cube::vertices[] = {
-    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-     0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-     0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-    -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-
-    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-     0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-     0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-    -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-
-    -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-    -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-    -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-    -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-
-     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-     0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-     0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-
-    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-     0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-
-    -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-     0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-     0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-    -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f
+    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+    -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
+
+    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+     0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
+     0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+    -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
+
+    -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+    -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+    -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+    -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+
+     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+     0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+     0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+
+    -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+     0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+    -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
 };
 
 const unsigned int Cube::indices[] = {
@@ -42,220 +46,301 @@ const unsigned int Cube::indices[] = {
     20, 21, 22, 22, 23, 20
 };
 
-const char* Cube::vertexShaderSource = R"(
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+const glm::vec3 Cube::LIGHT_POSITION(10.0f, 15.0f, 10.0f);
+const glm::vec3 Cube::VIEW_POSITION(10.0f, 15.0f, 35.0f);
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+int Cube::sharedUsers = 0;
+unsigned int Cube::VAO = 0;
+unsigned int Cube::VBO = 0;
+unsigned int Cube::EBO = 0;
+unsigned int Cube::shaderProgram = 0;
 
-out vec3 FragPos;
-out vec3 Normal;
-
-void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
-    
-    gl_Position = projection * view * vec4(FragPos, 1.0);
+Cube::Cube() : position(0.0f), color(0.5f, 0.5f, 0.5f) {
+    acquireShared();
 }
-)";
-
-const char* Cube::fragmentShaderSource = R"(
-#version 330 core
-out vec4 FragColor;
 
-in vec3 FragPos;
-in vec3 Normal;
-
-uniform vec3 cubeColor;
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform vec3 viewPos;
-
-void main() {
-    float ambientStrength = 0.4;
-    vec3 ambient = ambientStrength * lightColor;
-    
-    vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
-    
-    float specularStrength = 0.1;
-    vec3 viewDir = normalize(viewPos - FragPos);
-    vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 16);
-    vec3 specular = specularStrength * spec * lightColor;
-    
-    vec3 result = (ambient + diffuse + specular) * cubeColor;
-    FragColor = vec4(result, 1.0);
+Cube::Cube(float x, float y, float z, glm::vec3 color) : position(x, y, z), color(color) {
+    acquireShared();
 }
-)";
 
-Cube::Cube() : position(0.0f), color(0.5f, 0.5f, 0.5f) {
-    setupMesh();
-    createShaders();
+Cube::~Cube() {
+    releaseShared();
 }
 
-Cube::Cube(float x, float y, float z, glm::vec3 color) : position(x, y, z), color(color) {
+void Cube::acquireShared() {
+    if (sharedUsers++ > 0) return;
     setupMesh();
     createShaders();
 }
 
-Cube::~Cube() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
-    glDeleteVertexArrays(1, &edgeVAO);
-    glDeleteBuffers(1, &edgeVBO);
-    glDeleteProgram(shaderProgram);
-    glDeleteProgram(edgeShaderProgram);
+void Cube::releaseShared() {
+    if (--sharedUsers > 0) return;
+    RenderBackend& backend = RenderBackend::current();
+    backend.deleteVertexArray(VAO);
+    backend.deleteBuffer(VBO);
+    backend.deleteBuffer(EBO);
+    ShaderRegistry::release(&shaderProgram);
 }
 
 void Cube::setupMesh() {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Les contours pour un effet visuel
-    float edgeVertices[] = {
-        -0.5f, -0.5f, -0.5f,  0.5f, -0.5f, -0.5f,
-        -0.5f,  0.5f, -0.5f,  0.5f,  0.5f, -0.5f,
-        -0.5f, -0.5f,  0.5f,  0.5f, -0.5f,  0.5f,
-        -0.5f,  0.5f,  0.5f,  0.5f,  0.5f,  0.5f,
-        
-        -0.5f, -0.5f, -0.5f, -0.5f, -0.5f,  0.5f,
-         0.5f, -0.5f, -0.5f,  0.5f, -0.5f,  0.5f,
-        -0.5f,  0.5f, -0.5f, -0.5f,  0.5f,  0.5f,
-         0.5f,  0.5f, -0.5f,  0.5f,  0.5f,  0.5f,
-        
-        -0.5f, -0.5f, -0.5f, -0.5f,  0.5f, -0.5f,
-         0.5f, -0.5f, -0.5f,  0.5f,  0.5f, -0.5f,
-        -0.5f, -0.5f,  0.5f, -0.5f,  0.5f,  0.5f,
-         0.5f, -0.5f,  0.5f,  0.5f,  0.5f,  0.5f
-    };
-
-    glGenVertexArrays(1, &edgeVAO);
-    glGenBuffers(1, &edgeVBO);
-
-    glBindVertexArray(edgeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, edgeVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(edgeVertices), edgeVertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glBindVertexArray(0);
+    using BufferTarget = RenderBackend::BufferTarget;
+    RenderBackend& backend = RenderBackend::current();
+    VAO = backend.createVertexArray();
+    VBO = backend.createBuffer();
+    EBO = backend.createBuffer();
+
+    backend.bindVertexArray(VAO);
+
+    backend.bindBuffer(BufferTarget::VERTICES, VBO);
+    backend.bufferData(BufferTarget::VERTICES, sizeof(vertices), vertices,
+                       RenderBackend::BufferUsage::STATIC);
+
+    backend.bindBuffer(BufferTarget::INDICES, EBO);
+    backend.bufferData(BufferTarget::INDICES, sizeof(indices), indices,
+                       RenderBackend::BufferUsage::STATIC);
+
+    bindMeshAttributes();
+
+    backend.bindVertexArray(0);
+}
+
+// Position, normale et coordonnées dans la face (contours tracés par le fragment shader)
+void Cube::bindMeshAttributes() {
+    RenderBackend& backend = RenderBackend::current();
+    backend.vertexAttribute(0, 3, 8 * sizeof(float), 0);
+    backend.vertexAttribute(1, 3, 8 * sizeof(float), 3 * sizeof(float));
+    backend.vertexAttribute(2, 2, 8 * sizeof(float), 6 * sizeof(float));
 }
 
 void Cube::createShaders() {
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
+    ShaderRegistry::load("vertex_shader.glsl", "fragment_shader.glsl", &shaderProgram);
+}
 
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
+void Cube::setPosition(float x, float y, float z) {
+    position = glm::vec3(x, y, z);
+}
 
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
+void Cube::setColor(glm::vec3 color) {
+    this->color = color;
+}
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+void Cube::useFaceProgram(const glm::mat4& model, const glm::mat4& view,
+                          const glm::mat4& projection, glm::vec3 color) {
+    RenderBackend& backend = RenderBackend::current();
+    backend.useProgram(shaderProgram);
+    backend.setUniform(shaderProgram, "model", model);
+    backend.setUniform(shaderProgram, "view", view);
+    backend.setUniform(shaderProgram, "projection", projection);
+    
+    backend.setUniform(shaderProgram, "cubeColor", color);
+    backend.setUniform(shaderProgram, "lightPos", LIGHT_POSITION);
+    backend.setUniform(shaderProgram, "lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+    backend.setUniform(shaderProgram, "viewPos", VIEW_POSITION);
+    backend.setUniform(shaderProgram, "edgeWidth", EDGE_WIDTH);
+}
+
+void Cube::render(const glm::mat4& view, const glm::mat4& projection) {
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, position);
+    useFaceProgram(model, view, projection, color);
+
+    RenderBackend& backend = RenderBackend::current();
+    backend.bindVertexArray(VAO);
+    backend.drawElements(RenderBackend::Primitive::TRIANGLES, INDEX_COUNT);
+    backend.bindVertexArray(0);
+}
+
+CubeInstances::CubeInstances() : offset(0), count(0) {
+    using BufferTarget = RenderBackend::BufferTarget;
+    Cube::acquireShared();
+    ShaderRegistry::load("instanced_vertex_shader.glsl", "instanced_fragment_shader.glsl", &shaderProgram);
 
-    const char* edgeVertexSource = R"(
-#version 330 core
-layout (location = 0) in vec3 aPos;
+    RenderBackend& backend = RenderBackend::current();
+    backend.acquireStream();
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+    // Sommets du cube partagé ; les attributs d'instance sont pointés à chaque image
+    VAO = backend.createVertexArray();
+    backend.bindVertexArray(VAO);
+    backend.bindBuffer(BufferTarget::VERTICES, Cube::VBO);
+    Cube::bindMeshAttributes();
+    backend.bindBuffer(BufferTarget::INDICES, Cube::EBO);
 
-void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    backend.bindVertexArray(0);
 }
-)";
 
-    const char* edgeFragmentSource = R"(
-#version 330 core
-out vec4 FragColor;
-uniform vec3 edgeColor;
+CubeInstances::~CubeInstances() {
+    RenderBackend& backend = RenderBackend::current();
+    backend.deleteVertexArray(VAO);
+    backend.releaseStream();
+    ShaderRegistry::release(&shaderProgram);
+    Cube::releaseShared();
+}
 
-void main() {
-    FragColor = vec4(edgeColor, 1.0);
+void CubeInstances::upload(const std::vector<CubeInstance>& instances) {
+    count = static_cast<int>(instances.size());
+    if (count == 0) return;
+    offset = RenderBackend::current().streamData(instances.data(), instances.size() * sizeof(CubeInstance),
+                                                 sizeof(float));
 }
-)";
 
-    unsigned int edgeVertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(edgeVertexShader, 1, &edgeVertexSource, NULL);
-    glCompileShader(edgeVertexShader);
+// L'offset dans l'anneau change à chaque image (et le tampon s'il grandit)
+void CubeInstances::bindInstances() {
+    using BufferTarget = RenderBackend::BufferTarget;
+    RenderBackend& backend = RenderBackend::current();
+    backend.bindVertexArray(VAO);
+    backend.bindBuffer(BufferTarget::VERTICES, backend.streamBuffer());
+    backend.instanceAttribute(3, 3, sizeof(CubeInstance), offset + offsetof(CubeInstance, offset));
+    backend.instanceAttribute(4, 3, sizeof(CubeInstance), offset + offsetof(CubeInstance, color));
+}
 
-    unsigned int edgeFragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(edgeFragmentShader, 1, &edgeFragmentSource, NULL);
-    glCompileShader(edgeFragmentShader);
+void CubeInstances::render(const glm::mat4& view, const glm::mat4& projection,
+                           const glm::vec3& lightPosition, const glm::vec3& viewPosition, float edgeWidth) {
+    if (count == 0) return;
+    RenderBackend& backend = RenderBackend::current();
+    backend.useProgram(shaderProgram);
+    backend.setUniform(shaderProgram, "view", view);
+    backend.setUniform(shaderProgram, "projection", projection);
+    backend.setUniform(shaderProgram, "lightPos", lightPosition);
+    backend.setUniform(shaderProgram, "lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+    backend.setUniform(shaderProgram, "viewPos", viewPosition);
+    backend.setUniform(shaderProgram, "edgeWidth", edgeWidth);
+    bindInstances();
+    backend.drawElementsInstanced(RenderBackend::Primitive::TRIANGLES, Cube::INDEX_COUNT, count);
+    backend.bindVertexArray(0);
+}
 
-    edgeShaderProgram = glCreateProgram();
-    glAttachShader(edgeShaderProgram, edgeVertexShader);
-    glAttachShader(edgeShaderProgram, edgeFragmentShader);
-    glLinkProgram(edgeShaderProgram);
+namespace {
+
+// Disposition imposée par glMultiDrawElementsIndirect
+struct DrawCommand {
+    unsigned int count;
+    unsigned int instanceCount;
+    unsigned int firstIndex;
+    int baseVertex;
+    unsigned int baseInstance;
+};
 
-    glDeleteShader(edgeVertexShader);
-    glDeleteShader(edgeFragmentShader);
 }
 
-void Cube::setPosition(float x, float y, float z) {
-    position = glm::vec3(x, y, z);
+const glm::vec3 ResidentCubes::HIDDEN(-1.0f);
+
+ResidentCubes::ResidentCubes(const std::vector<int>& rangeSizes)
+    : commandsChanged(true), patchedInstances(0) {
+    using BufferTarget = RenderBackend::BufferTarget;
+    int total = 0;
+    for (int size : rangeSizes) {
+        ranges.push_back(Range{total, size, 0});
+        total += size;
+    }
+    instances.assign(total, CubeInstance{glm::vec3(0.0f), HIDDEN});
+
+    Cube::acquireShared();
+    ShaderRegistry::load("instanced_vertex_shader.glsl", "instanced_fragment_shader.glsl", &shaderProgram);
+
+    RenderBackend& backend = RenderBackend::current();
+    indirect = backend.supportsIndirectDraws();
+    instanceBuffer = backend.createBuffer();
+    backend.bindBuffer(BufferTarget::VERTICES, instanceBuffer);
+    backend.bufferData(BufferTarget::VERTICES, instances.size() * sizeof(CubeInstance), instances.data(),
+                       RenderBackend::BufferUsage::DYNAMIC);
+
+    commandBuffer = 0;
+    if (indirect) {
+        commandBuffer = backend.createBuffer();
+        backend.bindBuffer(BufferTarget::INDIRECT, commandBuffer);
+        backend.bufferData(BufferTarget::INDIRECT, ranges.size() * sizeof(DrawCommand), nullptr,
+                           RenderBackend::BufferUsage::DYNAMIC);
+    }
+
+    VAO = backend.createVertexArray();
+    backend.bindVertexArray(VAO);
+    backend.bindBuffer(BufferTarget::VERTICES, Cube::VBO);
+    Cube::bindMeshAttributes();
+    backend.bindBuffer(BufferTarget::INDICES, Cube::EBO);
+    bindRange(0);
+
+    backend.bindVertexArray(0);
 }
 
-void Cube::setColor(glm::vec3 color) {
-    this->color = color;
+ResidentCubes::~ResidentCubes() {
+    RenderBackend& backend = RenderBackend::current();
+    backend.deleteVertexArray(VAO);
+    backend.deleteBuffer(instanceBuffer);
+    if (commandBuffer) backend.deleteBuffer(commandBuffer);
+    ShaderRegistry::release(&shaderProgram);
+    Cube::releaseShared();
 }
 
-void Cube::render(const glm::mat4& view, const glm::mat4& projection) {
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, position);
+void ResidentCubes::write(int range, int first, const CubeInstance* source, int count) {
+    CubeInstance* target = instances.data() + ranges[range].first + first;
+    // Seule l'étendue entre la première et la dernière instance modifiées part au GPU
+    int begin = 0;
+    while (begin < count && std::memcmp(&target[begin], &source[begin], sizeof(CubeInstance)) == 0) begin++;
+    if (begin == count) return;
+    int end = count;
+    while (std::memcmp(&target[end - 1], &source[end - 1], sizeof(CubeInstance)) == 0) end--;
+
+    std::memcpy(target + begin, source + begin, (end - begin) * sizeof(CubeInstance));
+    RenderBackend& backend = RenderBackend::current();
+    backend.bindBuffer(RenderBackend::BufferTarget::VERTICES, instanceBuffer);
+    backend.bufferSubData(RenderBackend::BufferTarget::VERTICES,
+                          (target + begin - instances.data()) * sizeof(CubeInstance),
+                          (end - begin) * sizeof(CubeInstance), target + begin);
+    patchedInstances += end - begin;
+}
 
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    
-    glUniform3fv(glGetUniformLocation(shaderProgram, "cubeColor"), 1, glm::value_ptr(color));
-    glUniform3f(glGetUniformLocation(shaderProgram, "lightPos"), 10.0f, 15.0f, 10.0f);
-    glUniform3f(glGetUniformLocation(shaderProgram, "lightColor"), 1.0f, 1.0f, 1.0f);
-    glUniform3f(glGetUniformLocation(shaderProgram, "viewPos"), 10.0f, 15.0f, 35.0f);
-
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-
-    glUseProgram(edgeShaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(edgeShaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(glGetUniformLocation(edgeShaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(edgeShaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    
-    glm::vec3 edgeColor = color * 0.3f;
-    glUniform3fv(glGetUniformLocation(edgeShaderProgram, "edgeColor"), 1, glm::value_ptr(edgeColor));
+void ResidentCubes::setDrawCount(int range, int count) {
+    if (ranges[range].drawn == count) return;
+    ranges[range].drawn = count;
+    commandsChanged = true;
+}
 
-    glLineWidth(2.0f);
-    glBindVertexArray(edgeVAO);
-    glDrawArrays(GL_LINES, 0, 24);
-    
-    glBindVertexArray(0);
-}
\ No newline at end of file
+// Une commande par plage, renvoyées seulement quand un nombre d'instances change
+void ResidentCubes::uploadCommands() {
+    std::vector<DrawCommand> commands;
+    for (const Range& range : ranges) {
+        commands.push_back(DrawCommand{Cube::INDEX_COUNT, static_cast<unsigned int>(range.drawn), 0, 0,
+                                       static_cast<unsigned int>(range.first)});
+    }
+    RenderBackend& backend = RenderBackend::current();
+    backend.bindBuffer(RenderBackend::BufferTarget::INDIRECT, commandBuffer);
+    backend.bufferSubData(RenderBackend::BufferTarget::INDIRECT, 0, commands.size() * sizeof(DrawCommand),
+                          commands.data());
+    commandsChanged = false;
+}
+
+// Attributs d'instance lus à partir de l'instance first (repli sans base d'instance)
+void ResidentCubes::bindRange(int first) {
+    using BufferTarget = RenderBackend::BufferTarget;
+    RenderBackend& backend = RenderBackend::current();
+    backend.bindVertexArray(VAO);
+    backend.bindBuffer(BufferTarget::VERTICES, instanceBuffer);
+    size_t offset = static_cast<size_t>(first) * sizeof(CubeInstance);
+    backend.instanceAttribute(3, 3, sizeof(CubeInstance), offset + offsetof(CubeInstance, offset));
+    backend.instanceAttribute(4, 3, sizeof(CubeInstance), offset + offsetof(CubeInstance, color));
+}
+
+void ResidentCubes::render(const glm::mat4& view, const glm::mat4& projection,
+                           const glm::vec3& lightPosition, const glm::vec3& viewPosition, float edgeWidth) {
+    RenderBackend& backend = RenderBackend::current();
+    backend.useProgram(shaderProgram);
+    backend.setUniform(shaderProgram, "view", view);
+    backend.setUniform(shaderProgram, "projection", projection);
+    backend.setUniform(shaderProgram, "lightPos", lightPosition);
+    backend.setUniform(shaderProgram, "lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+    backend.setUniform(shaderProgram, "viewPos", viewPosition);
+    backend.setUniform(shaderProgram, "edgeWidth", edgeWidth);
+    if (indirect) {
+        if (commandsChanged) uploadCommands();
+        backend.bindVertexArray(VAO);
+        backend.bindBuffer(RenderBackend::BufferTarget::INDIRECT, commandBuffer);
+        backend.multiDrawElementsIndirect(RenderBackend::Primitive::TRIANGLES, 0, static_cast<int>(ranges.size()));
+    } else {
+        for (const Range& range : ranges) {
+            if (range.drawn == 0) continue;
+            bindRange(range.first);
+            backend.drawElementsInstanced(RenderBackend::Primitive::TRIANGLES, Cube::INDEX_COUNT, range.drawn);
+        }
+    }
+    backend.bindVertexArray(0);
+}
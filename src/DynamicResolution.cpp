@@ -0,0 +1,151 @@
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+// Poids d'une nouvelle mesure dans la moyenne glissante
+const float SMOOTHING = 0.2f;
+// On ne remonte que si le cran suivant tient dans cette part du budget
+const float UPSCALE_MARGIN = 0.85f;
+
+}
+
+bool DynamicResolution::parseArguments(int& argc, char** argv, Options& options) {
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--frame-budget") {
+            if (i + 1 >= argc) return false;
+            options.budgetMs = static_cast<float>(std::atof(argv[++i]));
+            if (options.budgetMs <= 0.0f) return false;
+        } else if (arg == "--min-scale") {
+            if (i + 1 >= argc) return false;
+            options.minScale = static_cast<float>(std::atof(argv[++i]));
+            if (options.minScale <= 0.0f || options.minScale > 1.0f) return false;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    return true;
+}
+
+void DynamicResolution::printUsage() {
+    std::cout << "       Tetris3D [--frame-budget MS] [--min-scale S]   (résolution dynamique de la scène)"
+              << std::endl;
+}
+
+DynamicResolution::DynamicResolution(const Options& options)
+    : budgetMs(options.budgetMs), minScale(options.minScale), scale(1.0f), averageMs(0.0f), cooldown(0),
+      framebuffer(0), colorBuffer(0), depthBuffer(0), bufferWidth(0), bufferHeight(0),
+      target(0), targetWidth(0), targetHeight(0), sceneWidth(0), sceneHeight(0), slot(0), created(false) {
+    for (int f = 0; f < FRAMES_IN_FLIGHT; f++) issued[f] = false;
+}
+
+DynamicResolution::~DynamicResolution() {
+    if (created) glDeleteQueries(FRAMES_IN_FLIGHT * 2, &queries[0][0]);
+    if (framebuffer) {
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteRenderbuffers(1, &colorBuffer);
+        glDeleteRenderbuffers(1, &depthBuffer);
+    }
+}
+
+void DynamicResolution::resizeBuffers(int width, int height) {
+    if (!framebuffer) {
+        glGenFramebuffers(1, &framebuffer);
+        glGenRenderbuffers(1, &colorBuffer);
+        glGenRenderbuffers(1, &depthBuffer);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    bufferWidth = width;
+    bufferHeight = height;
+}
+
+// Lit les timestamps d'une image passée s'ils sont revenus, sans attendre le GPU
+void DynamicResolution::collect(int frameSlot) {
+    if (!issued[frameSlot]) return;
+    issued[frameSlot] = false;
+    GLint ready = 0;
+    glGetQueryObjectiv(queries[frameSlot][1], GL_QUERY_RESULT_AVAILABLE, &ready);
+    if (!ready) return;
+
+    GLuint64 start = 0, end = 0;
+    glGetQueryObjectui64v(queries[frameSlot][0], GL_QUERY_RESULT, &start);
+    glGetQueryObjectui64v(queries[frameSlot][1], GL_QUERY_RESULT, &end);
+    adjust(end > start ? (end - start) / 1.0e6f : 0.0f);
+}
+
+void DynamicResolution::adjust(float sceneMs) {
+    averageMs = averageMs > 0.0f ? averageMs + (sceneMs - averageMs) * SMOOTHING : sceneMs;
+    // Les mesures encore en vol datent de l'échelle précédente
+    if (cooldown > 0) {
+        cooldown--;
+        return;
+    }
+
+    // Le coût de la scène suit le nombre de pixels, soit le carré de l'échelle
+    float next = scale;
+    if (averageMs > budgetMs) {
+        float wanted = scale * std::sqrt(budgetMs / averageMs);
+        next = std::floor(wanted / SCALE_STEP + 1e-3f) * SCALE_STEP;
+        next = std::max(minScale, std::min(next, scale - SCALE_STEP));
+    } else if (scale < 1.0f) {
+        float up = std::min(1.0f, scale + SCALE_STEP);
+        if (averageMs * (up * up) / (scale * scale) < budgetMs * UPSCALE_MARGIN) next = up;
+    }
+    if (next == scale) return;
+
+    averageMs *= (next * next) / (scale * scale);
+    scale = next;
+    cooldown = FRAMES_IN_FLIGHT;
+}
+
+void DynamicResolution::beginScene(int width, int height) {
+    if (!created) {
+        glGenQueries(FRAMES_IN_FLIGHT * 2, &queries[0][0]);
+        created = true;
+    }
+    // Le slot réutilisé est celui de l'image émise FRAMES_IN_FLIGHT images plus tôt
+    collect(slot);
+
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &target);
+    targetWidth = width;
+    targetHeight = height;
+    sceneWidth = std::max(1, static_cast<int>(width * scale + 0.5f));
+    sceneHeight = std::max(1, static_cast<int>(height * scale + 0.5f));
+
+    glQueryCounter(queries[slot][0], GL_TIMESTAMP);
+    if (scale >= 1.0f) return;
+
+    if (sceneWidth != bufferWidth || sceneHeight != bufferHeight) resizeBuffers(sceneWidth, sceneHeight);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, sceneWidth, sceneHeight);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void DynamicResolution::endScene() {
+    if (scale < 1.0f) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target);
+        glBlitFramebuffer(0, 0, sceneWidth, sceneHeight, 0, 0, targetWidth, targetHeight,
+                          GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, target);
+        glViewport(0, 0, targetWidth, targetHeight);
+    }
+    glQueryCounter(queries[slot][1], GL_TIMESTAMP);
+    issued[slot] = true;
+    slot = (slot + 1) % FRAMES_IN_FLIGHT;
+}
@@ -0,0 +1,235 @@
+#include "FrameCapture.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace {
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+unsigned char clampByte(int value) {
+    return static_cast<unsigned char>(std::min(255, std::max(0, value)));
+}
+
+}
+
+FrameCapture::FrameCapture()
+    : recording(false), y4m(false), pipe(false), output(nullptr), width(0), height(0), frameBytes(0),
+      issued(0), collected(0), written(0), dropped(0), stalls(0), stopping(false) {
+    for (int i = 0; i < PBO_COUNT; i++) {
+        pbos[i] = 0;
+        fences[i] = nullptr;
+    }
+}
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+bool FrameCapture::start(const std::string& path, int frameWidth, int frameHeight, int fps) {
+    if (recording) return false;
+
+    pipe = !path.empty() && path[0] == '|';
+    y4m = pipe || path == "-" || endsWith(path, ".y4m");
+    if (pipe) output = popen(path.c_str() + 1, "w");
+    else if (path == "-") output = stdout;
+    else output = std::fopen(path.c_str(), "wb");
+    if (!output) {
+        std::cout << "Impossible d'ouvrir la sortie vidéo : " << path << std::endl;
+        return false;
+    }
+
+    // Le 4:2:0 du Y4M demande des dimensions paires
+    width = y4m ? frameWidth & ~1 : frameWidth;
+    height = y4m ? frameHeight & ~1 : frameHeight;
+    frameBytes = static_cast<size_t>(width) * height * 4;
+    if (y4m) std::fprintf(output, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, fps);
+
+    glGenBuffers(PBO_COUNT, pbos);
+    for (int i = 0; i < PBO_COUNT; i++) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, NULL, GL_STREAM_READ);
+        fences[i] = nullptr;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    issued = collected = 0;
+    written = dropped = stalls = 0;
+    stopping = false;
+    recording = true;
+    writer = std::thread(&FrameCapture::writerLoop, this);
+
+    std::cout << "Enregistrement vidéo : " << path << " (" << width << "x" << height << ", "
+              << (y4m ? "Y4M" : "RGB24 brut") << ")" << std::endl;
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!recording) return;
+
+    // Les lectures encore en vol sont récupérées avant l'arrêt
+    while (collected < issued) collect(static_cast<int>(collected % PBO_COUNT), true);
+    glDeleteBuffers(PBO_COUNT, pbos);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_one();
+    writer.join();
+
+    if (pipe) pclose(output);
+    else if (output != stdout) std::fclose(output);
+    else std::fflush(output);
+    output = nullptr;
+    recording = false;
+
+    for (Frame* frame : freeFrames) delete frame;
+    freeFrames.clear();
+
+    std::cout << "Enregistrement terminé : " << written << " images, " << dropped << " perdues, "
+              << stalls << " attentes du GPU" << std::endl;
+}
+
+void FrameCapture::captureFrame() {
+    if (!recording) return;
+
+    // L'emplacement à réutiliser est lu avant d'y lancer une nouvelle copie
+    int slot = static_cast<int>(issued % PBO_COUNT);
+    if (issued - collected == PBO_COUNT) collect(slot, true);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[slot]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    issued++;
+
+    // Récupère sans attendre les copies déjà terminées
+    while (collected < issued - 1) {
+        int oldest = static_cast<int>(collected % PBO_COUNT);
+        if (glClientWaitSync(fences[oldest], 0, 0) == GL_TIMEOUT_EXPIRED) break;
+        collect(oldest, false);
+    }
+}
+
+void FrameCapture::collect(int slot, bool wait) {
+    if (wait && glClientWaitSync(fences[slot], 0, 0) == GL_TIMEOUT_EXPIRED) {
+        stalls++;
+        glClientWaitSync(fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+    }
+    glDeleteSync(fences[slot]);
+    fences[slot] = nullptr;
+    collected++;
+
+    Frame* frame = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.size() < MAX_QUEUED_FRAMES) {
+            if (!freeFrames.empty()) {
+                frame = freeFrames.back();
+                freeFrames.pop_back();
+            } else {
+                frame = new Frame();
+            }
+        }
+    }
+    if (!frame) {
+        dropped++;
+        return;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[slot]);
+    const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameBytes, GL_MAP_READ_BIT);
+    frame->pixels.resize(frameBytes);
+    if (pixels) std::memcpy(frame->pixels.data(), pixels, frameBytes);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(frame);
+    }
+    ready.notify_one();
+}
+
+void FrameCapture::writerLoop() {
+    std::vector<unsigned char> converted;
+    while (true) {
+        Frame* frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            frame = queue.front();
+            queue.pop_front();
+        }
+
+        writeFrame(*frame, converted);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        freeFrames.push_back(frame);
+        written++;
+    }
+}
+
+void FrameCapture::writeFrame(const Frame& frame, std::vector<unsigned char>& converted) {
+    const unsigned char* pixels = frame.pixels.data();
+    // OpenGL lit de bas en haut, les vidéos vont de haut en bas
+    auto pixel = [&](int x, int y) { return pixels + (static_cast<size_t>(height - 1 - y) * width + x) * 4; };
+
+    if (!y4m) {
+        converted.resize(static_cast<size_t>(width) * height * 3);
+        unsigned char* out = converted.data();
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                const unsigned char* p = pixel(x, y);
+                *out++ = p[0];
+                *out++ = p[1];
+                *out++ = p[2];
+            }
+        }
+        std::fwrite(converted.data(), 1, converted.size(), output);
+        return;
+    }
+
+    // YCbCr plein intervalle (BT.601, C420jpeg), chroma moyennée par blocs 2x2
+    size_t lumaSize = static_cast<size_t>(width) * height;
+    size_t chromaSize = lumaSize / 4;
+    converted.resize(lumaSize + 2 * chromaSize);
+    unsigned char* luma = converted.data();
+    unsigned char* cb = luma + lumaSize;
+    unsigned char* cr = cb + chromaSize;
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const unsigned char* p = pixel(x, y);
+            luma[y * width + x] = clampByte((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+    }
+    for (int y = 0; y < height; y += 2) {
+        for (int x = 0; x < width; x += 2) {
+            int r = 0, g = 0, b = 0;
+            for (int dy = 0; dy < 2; dy++) {
+                for (int dx = 0; dx < 2; dx++) {
+                    const unsigned char* p = pixel(x + dx, y + dy);
+                    r += p[0];
+                    g += p[1];
+                    b += p[2];
+                }
+            }
+            size_t index = (y / 2) * (width / 2) + x / 2;
+            cb[index] = clampByte(128 + ((-43 * r - 85 * g + 128 * b + 512) >> 10));
+            cr[index] = clampByte(128 + ((128 * r - 107 * g - 21 * b + 512) >> 10));
+        }
+    }
+    std::fputs("FRAME\n", output);
+    std::fwrite(converted.data(), 1, converted.size(), output);
+}
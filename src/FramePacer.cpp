@@ -0,0 +1,140 @@
+#include "FramePacer.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+// En deçà, sleep_for n'est plus assez précis : on attend activement
+const double SPIN_SECONDS = 0.0015;
+// Marge pour les variations du coût d'une image
+const double SAFETY_SECONDS = 0.001;
+
+void waitUntil(std::chrono::steady_clock::time_point deadline) {
+    auto sleepUntil = deadline - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(SPIN_SECONDS));
+    if (std::chrono::steady_clock::now() < sleepUntil) std::this_thread::sleep_until(sleepUntil);
+    while (std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+}
+
+std::chrono::steady_clock::duration seconds(double value) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(value));
+}
+
+// Écran de la fenêtre : celui du plein écran, sinon celui qui contient son
+// centre ; l'écran principal si la position est inconnue (Wayland)
+GLFWmonitor* windowMonitor(GLFWwindow* window) {
+    if (!window) return glfwGetPrimaryMonitor();
+    if (GLFWmonitor* fullscreen = glfwGetWindowMonitor(window)) return fullscreen;
+
+    int x = 0, y = 0, width = 0, height = 0;
+    glfwGetWindowPos(window, &x, &y);
+    glfwGetWindowSize(window, &width, &height);
+    int centerX = x + width / 2;
+    int centerY = y + height / 2;
+
+    int count = 0;
+    GLFWmonitor** monitors = glfwGetMonitors(&count);
+    for (int i = 0; i < count; i++) {
+        const GLFWvidmode* mode = glfwGetVideoMode(monitors[i]);
+        if (!mode) continue;
+        int monitorX = 0, monitorY = 0;
+        glfwGetMonitorPos(monitors[i], &monitorX, &monitorY);
+        if (centerX >= monitorX && centerX < monitorX + mode->width &&
+            centerY >= monitorY && centerY < monitorY + mode->height) {
+            return monitors[i];
+        }
+    }
+    return glfwGetPrimaryMonitor();
+}
+
+}
+
+bool FramePacer::parseArguments(int& argc, char** argv, Options& options) {
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--no-vsync") {
+            options.vsync = false;
+        } else if (arg == "--continuous") {
+            options.continuous = true;
+        } else if (arg == "--fps-cap") {
+            if (i + 1 >= argc) return false;
+            options.fpsCap = std::atof(argv[++i]);
+            if (options.fpsCap <= 0.0) return false;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    return true;
+}
+
+void FramePacer::printUsage() {
+    std::cout << "       Tetris3D [--continuous] [--no-vsync] [--fps-cap N]" << std::endl;
+}
+
+FramePacer::FramePacer(GLFWwindow* window, const Options& options)
+    : periodSeconds(0.0), vsync(options.vsync), sampleCount(0), sampleIndex(0), hasPresented(false) {
+    glfwSwapInterval(options.vsync ? 1 : 0);
+
+    if (options.vsync) {
+        // Période de rafraîchissement de l'écran de la fenêtre (60 Hz par défaut)
+        GLFWmonitor* monitor = windowMonitor(window);
+        const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+        int refreshRate = mode && mode->refreshRate > 0 ? mode->refreshRate : 60;
+        periodSeconds = 1.0 / refreshRate;
+    }
+    if (options.fpsCap > 0.0) periodSeconds = std::max(periodSeconds, 1.0 / options.fpsCap);
+}
+
+void FramePacer::waitForFrameStart() {
+    if (periodSeconds <= 0.0 || !hasPresented) return;
+
+    // Prochaine présentation moins le coût prévu : les entrées lues ensuite
+    // arrivent encore dans l'image
+    double lead = std::min(getPredictedWorkMs() / 1000.0 + SAFETY_SECONDS, periodSeconds);
+    waitUntil(nextPresent - seconds(lead));
+}
+
+void FramePacer::waitForPresent() {
+    // Avec vsync, glfwSwapBuffers attend déjà le retour de trame
+    if (vsync || periodSeconds <= 0.0 || !hasPresented) return;
+    waitUntil(nextPresent);
+}
+
+void FramePacer::beginWork() {
+    workStart = Clock::now();
+}
+
+void FramePacer::endWork() {
+    workSamples[sampleIndex] = std::chrono::duration<double, std::milli>(Clock::now() - workStart).count();
+    sampleIndex = (sampleIndex + 1) % HISTORY;
+    sampleCount = std::min(sampleCount + 1, static_cast<int>(HISTORY));
+}
+
+void FramePacer::framePresented() {
+    Clock::time_point now = Clock::now();
+    // Avec vsync, le retour de glfwSwapBuffers suit le retour de trame ; sans
+    // vsync, les échéances avancent d'une période fixe pour ne pas dériver
+    if (vsync || !hasPresented || now > nextPresent + seconds(periodSeconds)) nextPresent = now;
+    nextPresent += seconds(periodSeconds);
+    hasPresented = true;
+}
+
+double FramePacer::getPeriodMs() const {
+    return periodSeconds * 1000.0;
+}
+
+double FramePacer::getPredictedWorkMs() const {
+    if (sampleCount == 0) return 0.0;
+    // 90e centile des dernières images : une image lente isolée ne décale pas tout
+    double sorted[HISTORY];
+    std::copy(workSamples, workSamples + sampleCount, sorted);
+    std::sort(sorted, sorted + sampleCount);
+    return sorted[std::min(sampleCount - 1, sampleCount * 9 / 10)];
+}
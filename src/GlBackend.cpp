@@ -0,0 +1,249 @@
+#include "GlBackend.h"
+#include "ShaderCache.h"
+#include "StreamBuffer.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+
+GLenum toGl(RenderBackend::Primitive primitive) {
+    switch (primitive) {
+        case RenderBackend::Primitive::TRIANGLES: return GL_TRIANGLES;
+    }
+    return GL_TRIANGLES;
+}
+
+GLenum toGl(RenderBackend::BufferTarget target) {
+    switch (target) {
+        case RenderBackend::BufferTarget::INDICES: return GL_ELEMENT_ARRAY_BUFFER;
+        case RenderBackend::BufferTarget::INDIRECT: return GL_DRAW_INDIRECT_BUFFER;
+        default: return GL_ARRAY_BUFFER;
+    }
+}
+
+GLenum toGl(RenderBackend::BufferUsage usage) {
+    return usage == RenderBackend::BufferUsage::DYNAMIC ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
+}
+
+}
+
+unsigned int GlBackend::createVertexArray() {
+    GLuint vertexArray = 0;
+    glGenVertexArrays(1, &vertexArray);
+    return vertexArray;
+}
+
+// GL délie un objet supprimé : son nom peut resservir à un objet créé ensuite
+void GlBackend::deleteVertexArray(unsigned int vertexArray) {
+    glDeleteVertexArrays(1, &vertexArray);
+    if (boundVertexArray == vertexArray) boundVertexArray = 0;
+    if (pendingVertexArray == vertexArray) pendingVertexArray = 0;
+}
+
+unsigned int GlBackend::createBuffer() {
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    return buffer;
+}
+
+void GlBackend::deleteBuffer(unsigned int buffer) {
+    glDeleteBuffers(1, &buffer);
+    if (boundVertexBuffer == buffer) boundVertexBuffer = 0;
+    if (boundIndirectBuffer == buffer) boundIndirectBuffer = 0;
+}
+
+unsigned int GlBackend::createProgram(const char* vertexSource, const char* fragmentSource) {
+    return ShaderCache::buildProgram(vertexSource, fragmentSource);
+}
+
+// Un programme rechargé reçoit un nouveau nom : ses uniformes repartent de zéro
+void GlBackend::deleteProgram(unsigned int program) {
+    glDeleteProgram(program);
+    if (currentProgram == program) currentProgram = UNKNOWN;
+    uniforms.erase(std::remove_if(uniforms.begin(), uniforms.end(),
+                                  [program](const Uniform& uniform) { return uniform.program == program; }),
+                   uniforms.end());
+}
+
+unsigned int GlBackend::createTexture() {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    return texture;
+}
+
+void GlBackend::deleteTexture(unsigned int texture) {
+    glDeleteTextures(1, &texture);
+}
+
+void GlBackend::bindVertexArray(unsigned int vertexArray) {
+    pendingVertexArray = vertexArray;
+}
+
+void GlBackend::applyVertexArray() {
+    if (pendingVertexArray == boundVertexArray) return;
+    glBindVertexArray(pendingVertexArray);
+    boundVertexArray = pendingVertexArray;
+}
+
+// Le tampon d'indices fait partie de l'état du VAO, les deux autres liaisons sont globales
+void GlBackend::bindBuffer(BufferTarget target, unsigned int buffer) {
+    if (target == BufferTarget::INDICES) {
+        applyVertexArray();
+    } else {
+        unsigned int& bound = target == BufferTarget::INDIRECT ? boundIndirectBuffer : boundVertexBuffer;
+        if (bound == buffer) return;
+        bound = buffer;
+    }
+    glBindBuffer(toGl(target), buffer);
+}
+
+void GlBackend::bufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) {
+    if (target == BufferTarget::INDICES) applyVertexArray();
+    glBufferData(toGl(target), size, data, toGl(usage));
+}
+
+void GlBackend::bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) {
+    if (target == BufferTarget::INDICES) applyVertexArray();
+    glBufferSubData(toGl(target), offset, size, data);
+}
+
+void GlBackend::acquireStream() {
+    if (streamUsers++ == 0) stream = new StreamBuffer();
+}
+
+void GlBackend::releaseStream() {
+    if (--streamUsers > 0) return;
+    delete stream;
+    stream = nullptr;
+    boundVertexBuffer = UNKNOWN;
+}
+
+// StreamBuffer lie lui-même GL_ARRAY_BUFFER pour créer, mapper ou agrandir l'anneau
+size_t GlBackend::streamData(const void* data, size_t size, size_t alignment) {
+    size_t offset = stream->write(data, size, alignment);
+    boundVertexBuffer = UNKNOWN;
+    return offset;
+}
+
+unsigned int GlBackend::streamBuffer() {
+    return stream->getBuffer();
+}
+
+void GlBackend::vertexAttribute(unsigned int index, int components, size_t stride, size_t offset) {
+    applyVertexArray();
+    glVertexAttribPointer(index, components, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride),
+                          reinterpret_cast<const void*>(offset));
+    glEnableVertexAttribArray(index);
+}
+
+void GlBackend::instanceAttribute(unsigned int index, int components, size_t stride, size_t offset) {
+    vertexAttribute(index, components, stride, offset);
+    glVertexAttribDivisor(index, 1);
+}
+
+void GlBackend::bindTexture(int unit, unsigned int texture) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GlBackend::textureImage(int width, int height, const void* data) {
+    // Lignes d'octets sans remplissage, quelle que soit la largeur
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, width, height, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, data);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+void GlBackend::textureSubImage(int firstRow, int width, int rows, const void* data) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, firstRow, width, rows, GL_RED_INTEGER, GL_UNSIGNED_BYTE, data);
+}
+
+void GlBackend::useProgram(unsigned int program) {
+    if (program == currentProgram) return;
+    glUseProgram(program);
+    currentProgram = program;
+}
+
+// Les valeurs des uniformes restent attachées à leur programme : le cache vaut
+// d'un changement de programme à l'autre. L'emplacement n'est demandé qu'une fois.
+int GlBackend::changedUniform(unsigned int program, const char* name, const void* value, size_t size) {
+    Uniform* uniform = nullptr;
+    for (Uniform& entry : uniforms) {
+        if (entry.program == program && entry.name == name) {
+            uniform = &entry;
+            break;
+        }
+    }
+    if (!uniform) {
+        uniforms.push_back(Uniform{program, name, glGetUniformLocation(program, name), {}, 0});
+        uniform = &uniforms.back();
+    } else if (uniform->size == size && std::memcmp(uniform->value, value, size) == 0) {
+        return -1;
+    }
+    std::memcpy(uniform->value, value, size);
+    uniform->size = size;
+    return uniform->location;
+}
+
+void GlBackend::setUniform(unsigned int program, const char* name, const glm::mat4& value) {
+    int location = changedUniform(program, name, glm::value_ptr(value), sizeof(value));
+    if (location >= 0) glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void GlBackend::setUniform(unsigned int program, const char* name, const glm::vec3& value) {
+    int location = changedUniform(program, name, glm::value_ptr(value), sizeof(value));
+    if (location >= 0) glUniform3fv(location, 1, glm::value_ptr(value));
+}
+
+void GlBackend::setUniform(unsigned int program, const char* name, int value) {
+    int location = changedUniform(program, name, &value, sizeof(value));
+    if (location >= 0) glUniform1i(location, value);
+}
+
+void GlBackend::setUniform(unsigned int program, const char* name, float value) {
+    int location = changedUniform(program, name, &value, sizeof(value));
+    if (location >= 0) glUniform1f(location, value);
+}
+
+void GlBackend::setDepthTest(bool enabled) {
+    if (depthTest == static_cast<int>(enabled)) return;
+    if (enabled) glEnable(GL_DEPTH_TEST);
+    else glDisable(GL_DEPTH_TEST);
+    depthTest = enabled;
+}
+
+void GlBackend::drawArrays(Primitive primitive, int first, int count) {
+    applyVertexArray();
+    glDrawArrays(toGl(primitive), first, count);
+}
+
+void GlBackend::drawElements(Primitive primitive, int count) {
+    applyVertexArray();
+    glDrawElements(toGl(primitive), count, GL_UNSIGNED_INT, 0);
+}
+
+void GlBackend::drawElementsInstanced(Primitive primitive, int count, int instances) {
+    applyVertexArray();
+    glDrawElementsInstanced(toGl(primitive), count, GL_UNSIGNED_INT, 0, instances);
+}
+
+// TETRIS3D_DRAW=instanced impose le repli GL 3.3 (une draw call instanciée par plage)
+bool GlBackend::supportsIndirectDraws() {
+    const char* mode = std::getenv("TETRIS3D_DRAW");
+    return GLAD_GL_VERSION_4_3 && !(mode && std::strcmp(mode, "instanced") == 0);
+}
+
+void GlBackend::multiDrawElementsIndirect(Primitive primitive, size_t offset, int drawCount) {
+    applyVertexArray();
+    glMultiDrawElementsIndirect(toGl(primitive), GL_UNSIGNED_INT, reinterpret_cast<const void*>(offset), drawCount, 0);
+}
+
+void GlBackend::endFrame() {
+    if (stream) stream->endFrame();
+}
@@ -0,0 +1,217 @@
+#include "GlStats.h"
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+GlStats::Counters current;
+GlStats::Counters previous;
+bool installed = false;
+std::ofstream csv;
+unsigned long long frameIndex = 0;
+
+PFNGLDRAWARRAYSPROC realDrawArrays;
+PFNGLDRAWELEMENTSPROC realDrawElements;
+PFNGLDRAWARRAYSINSTANCEDPROC realDrawArraysInstanced;
+PFNGLDRAWELEMENTSINSTANCEDPROC realDrawElementsInstanced;
+PFNGLMULTIDRAWARRAYSINDIRECTPROC realMultiDrawArraysIndirect;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC realMultiDrawElementsIndirect;
+PFNGLUSEPROGRAMPROC realUseProgram;
+PFNGLBINDVERTEXARRAYPROC realBindVertexArray;
+PFNGLBUFFERDATAPROC realBufferData;
+PFNGLBUFFERSUBDATAPROC realBufferSubData;
+PFNGLGETUNIFORMLOCATIONPROC realGetUniformLocation;
+PFNGLUNIFORM1IPROC realUniform1i;
+PFNGLUNIFORM1FPROC realUniform1f;
+PFNGLUNIFORM3FPROC realUniform3f;
+PFNGLUNIFORM3FVPROC realUniform3fv;
+PFNGLUNIFORM4FVPROC realUniform4fv;
+PFNGLUNIFORMMATRIX4FVPROC realUniformMatrix4fv;
+
+void APIENTRY countDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    current.drawCalls++;
+    realDrawArrays(mode, first, count);
+}
+
+void APIENTRY countDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    current.drawCalls++;
+    realDrawElements(mode, count, type, indices);
+}
+
+void APIENTRY countDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+    current.drawCalls++;
+    realDrawArraysInstanced(mode, first, count, instances);
+}
+
+void APIENTRY countDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices,
+                                         GLsizei instances) {
+    current.drawCalls++;
+    realDrawElementsInstanced(mode, count, type, indices, instances);
+}
+
+// Une multi-draw indirecte compte pour un seul appel, quel que soit le nombre de commandes
+void APIENTRY countMultiDrawArraysIndirect(GLenum mode, const void* indirect, GLsizei drawCount, GLsizei stride) {
+    current.drawCalls++;
+    realMultiDrawArraysIndirect(mode, indirect, drawCount, stride);
+}
+
+void APIENTRY countMultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawCount,
+                                             GLsizei stride) {
+    current.drawCalls++;
+    realMultiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+}
+
+void APIENTRY countUseProgram(GLuint program) {
+    current.programBinds++;
+    realUseProgram(program);
+}
+
+void APIENTRY countBindVertexArray(GLuint array) {
+    current.vaoBinds++;
+    realBindVertexArray(array);
+}
+
+void APIENTRY countBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    current.bufferUploads++;
+    if (data) current.bytesUploaded += size;
+    realBufferData(target, size, data, usage);
+}
+
+void APIENTRY countBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    current.bufferUploads++;
+    current.bytesUploaded += size;
+    realBufferSubData(target, offset, size, data);
+}
+
+GLint APIENTRY countGetUniformLocation(GLuint program, const GLchar* name) {
+    current.uniformLookups++;
+    return realGetUniformLocation(program, name);
+}
+
+void APIENTRY countUniform1i(GLint location, GLint v0) {
+    current.uniformUpdates++;
+    realUniform1i(location, v0);
+}
+
+void APIENTRY countUniform1f(GLint location, GLfloat v0) {
+    current.uniformUpdates++;
+    realUniform1f(location, v0);
+}
+
+void APIENTRY countUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    current.uniformUpdates++;
+    realUniform3f(location, v0, v1, v2);
+}
+
+void APIENTRY countUniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+    current.uniformUpdates++;
+    realUniform3fv(location, count, value);
+}
+
+void APIENTRY countUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+    current.uniformUpdates++;
+    realUniform4fv(location, count, value);
+}
+
+void APIENTRY countUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    current.uniformUpdates++;
+    realUniformMatrix4fv(location, count, transpose, value);
+}
+
+// Remplace un pointeur glad par sa version comptée, ou restaure l'original.
+// Un point d'entrée absent du contexte reste nul.
+template <typename Proc>
+void hookEntry(bool install, Proc& glad, Proc& real, Proc wrapper) {
+    if (install && glad && glad != wrapper) {
+        real = glad;
+        glad = wrapper;
+    } else if (!install && glad == wrapper) {
+        glad = real;
+    }
+}
+
+void hookAll(bool install) {
+    hookEntry(install, glad_glDrawArrays, realDrawArrays, countDrawArrays);
+    hookEntry(install, glad_glDrawElements, realDrawElements, countDrawElements);
+    hookEntry(install, glad_glDrawArraysInstanced, realDrawArraysInstanced, countDrawArraysInstanced);
+    hookEntry(install, glad_glDrawElementsInstanced, realDrawElementsInstanced, countDrawElementsInstanced);
+    hookEntry(install, glad_glMultiDrawArraysIndirect, realMultiDrawArraysIndirect, countMultiDrawArraysIndirect);
+    hookEntry(install, glad_glMultiDrawElementsIndirect, realMultiDrawElementsIndirect,
+              countMultiDrawElementsIndirect);
+    hookEntry(install, glad_glUseProgram, realUseProgram, countUseProgram);
+    hookEntry(install, glad_glBindVertexArray, realBindVertexArray, countBindVertexArray);
+    hookEntry(install, glad_glBufferData, realBufferData, countBufferData);
+    hookEntry(install, glad_glBufferSubData, realBufferSubData, countBufferSubData);
+    hookEntry(install, glad_glGetUniformLocation, realGetUniformLocation, countGetUniformLocation);
+    hookEntry(install, glad_glUniform1i, realUniform1i, countUniform1i);
+    hookEntry(install, glad_glUniform1f, realUniform1f, countUniform1f);
+    hookEntry(install, glad_glUniform3f, realUniform3f, countUniform3f);
+    hookEntry(install, glad_glUniform3fv, realUniform3fv, countUniform3fv);
+    hookEntry(install, glad_glUniform4fv, realUniform4fv, countUniform4fv);
+    hookEntry(install, glad_glUniformMatrix4fv, realUniformMatrix4fv, countUniformMatrix4fv);
+}
+
+}
+
+bool GlStats::enable(const std::string& csvPath) {
+    if (installed) return true;
+    if (!glad_glDrawElements) {
+        std::cout << "GlStats : OpenGL n'est pas encore chargé" << std::endl;
+        return false;
+    }
+
+    if (!csvPath.empty()) {
+        csv.open(csvPath);
+        if (!csv) {
+            std::cout << "Impossible d'écrire " << csvPath << std::endl;
+        } else {
+            csv << "frame,draw_calls,program_binds,vao_binds,buffer_uploads,bytes_uploaded,"
+                   "uniform_updates,uniform_lookups,stream_stalls\n";
+        }
+    }
+
+    hookAll(true);
+    installed = true;
+    current = Counters();
+    previous = Counters();
+    frameIndex = 0;
+    return true;
+}
+
+void GlStats::disable() {
+    if (!installed) return;
+    hookAll(false);
+    installed = false;
+    if (csv.is_open()) csv.close();
+}
+
+bool GlStats::isEnabled() {
+    return installed;
+}
+
+void GlStats::endFrame() {
+    if (!installed) return;
+    previous = current;
+    current = Counters();
+
+    if (csv.is_open()) {
+        csv << frameIndex << ',' << previous.drawCalls << ',' << previous.programBinds << ','
+            << previous.vaoBinds << ',' << previous.bufferUploads << ',' << previous.bytesUploaded << ','
+            << previous.uniformUpdates << ',' << previous.uniformLookups << ',' << previous.streamStalls << '\n';
+    }
+    frameIndex++;
+}
+
+const GlStats::Counters& GlStats::lastFrame() {
+    return previous;
+}
+
+void GlStats::countStreamUpload(size_t bytes) {
+    if (!installed) return;
+    current.bufferUploads++;
+    current.bytesUploaded += bytes;
+}
+
+void GlStats::countStreamStall() {
+    if (installed) current.streamStalls++;
+}
@@ -0,0 +1,89 @@
+#include "GpuTimer.h"
+
+GpuTimer::GpuTimer()
+    : slot(0), enabled(true), active(false), created(false), resultsReady(false), droppedFrames(0) {
+    for (int f = 0; f < FRAMES_IN_FLIGHT; f++) {
+        for (int p = 0; p < PASS_COUNT; p++) issued[f][p] = false;
+    }
+    for (int p = 0; p < PASS_COUNT; p++) passMs[p] = 0.0f;
+}
+
+GpuTimer::~GpuTimer() {
+    if (created) glDeleteQueries(FRAMES_IN_FLIGHT * PASS_COUNT, &queries[0][0]);
+}
+
+const char* GpuTimer::passName(Pass pass) {
+    switch (pass) {
+        case CUBES: return "cubes";
+        case HUD: return "hud";
+        default: return "?";
+    }
+}
+
+float GpuTimer::getTotalMs() const {
+    float total = 0.0f;
+    for (int p = 0; p < PASS_COUNT; p++) total += passMs[p];
+    return total;
+}
+
+// Lit les requêtes d'une image passée si elles sont toutes revenues ;
+// sinon l'image est abandonnée plutôt que de bloquer sur le GPU
+void GpuTimer::collect(int frameSlot) {
+    bool any = false;
+    bool available = true;
+    for (int p = 0; p < PASS_COUNT; p++) {
+        if (!issued[frameSlot][p]) continue;
+        any = true;
+        GLint ready = 0;
+        glGetQueryObjectiv(queries[frameSlot][p], GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (!ready) available = false;
+    }
+    if (!any) return;
+
+    if (available) {
+        for (int p = 0; p < PASS_COUNT; p++) {
+            if (!issued[frameSlot][p]) continue;
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(queries[frameSlot][p], GL_QUERY_RESULT, &elapsed);
+            passMs[p] = elapsed / 1.0e6f;
+        }
+        resultsReady = true;
+    } else {
+        droppedFrames++;
+    }
+    for (int p = 0; p < PASS_COUNT; p++) issued[frameSlot][p] = false;
+}
+
+void GpuTimer::setEnabled(bool value) {
+    if (value && !enabled) resultsReady = false;
+    enabled = value;
+}
+
+void GpuTimer::beginFrame() {
+    if (!enabled) return;
+    // Requêtes créées au premier usage : un minuteur désactivé ne touche pas à GL
+    if (!created) {
+        glGenQueries(FRAMES_IN_FLIGHT * PASS_COUNT, &queries[0][0]);
+        created = true;
+    }
+    // Le slot réutilisé est celui de l'image émise FRAMES_IN_FLIGHT images plus tôt
+    collect(slot);
+}
+
+void GpuTimer::begin(Pass pass) {
+    if (!enabled) return;
+    glBeginQuery(GL_TIME_ELAPSED, queries[slot][pass]);
+    issued[slot][pass] = true;
+    active = true;
+}
+
+void GpuTimer::end() {
+    if (!active) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    active = false;
+}
+
+void GpuTimer::endFrame() {
+    if (!enabled) return;
+    slot = (slot + 1) % FRAMES_IN_FLIGHT;
+}
@@ -0,0 +1,203 @@
+#include "HeadlessContext.h"
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#ifdef TETRIS3D_HEADLESS
+// Pas besoin des types X11 (et de leurs macros) dans eglplatform.h
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace {
+
+EGLDisplay openDisplay(bool& surfaceless) {
+    // Plateforme surfaceless de Mesa : aucun serveur X ni Wayland nécessaire
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (getPlatformDisplay && extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless")) {
+        EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, NULL, NULL)) {
+            surfaceless = true;
+            return display;
+        }
+    }
+    surfaceless = false;
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display != EGL_NO_DISPLAY && eglInitialize(display, NULL, NULL)) return display;
+    return EGL_NO_DISPLAY;
+}
+
+}
+#endif
+
+bool HeadlessContext::parseArguments(int& argc, char** argv, Options& options) {
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            options.enabled = true;
+        } else if (arg == "--screenshot" || arg == "--record") {
+            if (i + 1 >= argc) return false;
+            (arg == "--screenshot" ? options.screenshot : options.record) = argv[++i];
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    // Capture d'écran et vidéo n'existent qu'en mode headless
+    return options.enabled || (options.screenshot.empty() && options.record.empty());
+}
+
+void HeadlessContext::printUsage() {
+    std::cout << "       Tetris3D --headless [--stress ...] [--screenshot F.ppm] [--record F.y4m]" << std::endl;
+}
+
+bool HeadlessContext::isAvailable() {
+#ifdef TETRIS3D_HEADLESS
+    return true;
+#else
+    return false;
+#endif
+}
+
+HeadlessContext::HeadlessContext()
+    : display(nullptr), surface(nullptr), context(nullptr),
+      framebuffer(0), colorBuffer(0), depthBuffer(0), width(0), height(0) {}
+
+HeadlessContext::~HeadlessContext() {
+    destroy();
+}
+
+bool HeadlessContext::create(int frameWidth, int frameHeight) {
+#ifdef TETRIS3D_HEADLESS
+    bool surfaceless = false;
+    EGLDisplay eglDisplay = openDisplay(surfaceless);
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        std::cout << "Aucun affichage EGL disponible" << std::endl;
+        return false;
+    }
+    display = eglDisplay;
+
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    // En surfaceless, EGL_KHR_no_config_context évite de choisir une config
+    if (!surfaceless && (!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount) || configCount == 0)) {
+        std::cout << "Aucune configuration EGL compatible" << std::endl;
+        destroy();
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    context = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+    if (context == EGL_NO_CONTEXT) {
+        std::cout << "Échec de la création du contexte OpenGL 3.3 (EGL)" << std::endl;
+        context = nullptr;
+        destroy();
+        return false;
+    }
+
+    EGLSurface eglSurface = EGL_NO_SURFACE;
+    if (!surfaceless) {
+        // Le pbuffer ne sert qu'à rendre le contexte courant : le rendu va dans le FBO
+        const EGLint surfaceAttributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+        eglSurface = eglCreatePbufferSurface(eglDisplay, config, surfaceAttributes);
+        surface = eglSurface;
+    }
+    if (!eglMakeCurrent(eglDisplay, eglSurface, eglSurface, static_cast<EGLContext>(context))) {
+        std::cout << "Impossible d'activer le contexte EGL" << std::endl;
+        destroy();
+        return false;
+    }
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+        std::cout << "Échec de l'initialisation de GLAD" << std::endl;
+        destroy();
+        return false;
+    }
+
+    width = frameWidth;
+    height = frameHeight;
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(1, &colorBuffer);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cout << "Framebuffer headless incomplet" << std::endl;
+        destroy();
+        return false;
+    }
+    glViewport(0, 0, width, height);
+
+    std::cout << "Contexte headless " << (surfaceless ? "surfaceless" : "pbuffer") << " : "
+              << glGetString(GL_RENDERER) << ", " << glGetString(GL_VERSION) << std::endl;
+    return true;
+#else
+    (void)frameWidth;
+    (void)frameHeight;
+    std::cout << "Mode headless indisponible : EGL introuvable à la compilation" << std::endl;
+    return false;
+#endif
+}
+
+void HeadlessContext::destroy() {
+#ifdef TETRIS3D_HEADLESS
+    if (!display) return;
+    if (context && framebuffer) {
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteRenderbuffers(1, &colorBuffer);
+        glDeleteRenderbuffers(1, &depthBuffer);
+    }
+    framebuffer = colorBuffer = depthBuffer = 0;
+
+    EGLDisplay eglDisplay = static_cast<EGLDisplay>(display);
+    eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (surface) eglDestroySurface(eglDisplay, static_cast<EGLSurface>(surface));
+    if (context) eglDestroyContext(eglDisplay, static_cast<EGLContext>(context));
+    eglTerminate(eglDisplay);
+    display = surface = context = nullptr;
+#endif
+}
+
+bool HeadlessContext::writeScreenshot(const std::string& path) const {
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cout << "Impossible d'écrire la capture : " << path << std::endl;
+        return false;
+    }
+    std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+    // OpenGL lit de bas en haut
+    for (int y = height - 1; y >= 0; y--) {
+        std::fwrite(pixels.data() + static_cast<size_t>(y) * width * 3, 1, static_cast<size_t>(width) * 3, file);
+    }
+    std::fclose(file);
+    std::cout << "Capture écrite dans " << path << std::endl;
+    return true;
+}
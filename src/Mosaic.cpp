@@ -0,0 +1,244 @@
+#include "Mosaic.h"
+#include "Cube.h"
+#include "Profiler.h"
+#include "RenderBackend.h"
+#include "TextRenderer.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+// Écart entre deux puits et place réservée au score au-dessus de chacun (en cubes)
+const int BOARD_GAP = 2;
+const int LABEL_ROWS = 3;
+// Au-delà, le retard est abandonné plutôt que rattrapé
+const int MAX_TICKS_PER_UPDATE = 4;
+const float HEADER_HEIGHT = 30.0f;
+
+}
+
+bool Mosaic::parseArguments(int& argc, char** argv, Options& options) {
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--mosaic") {
+            if (i + 1 >= argc) return false;
+            options.boards = std::atoi(argv[++i]);
+            if (options.boards < MIN_BOARDS || options.boards > MAX_BOARDS) return false;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    return true;
+}
+
+void Mosaic::printUsage() {
+    std::cout << "       Tetris3D --mosaic N   (" << MIN_BOARDS << " à " << MAX_BOARDS
+              << " parties de l'Autoplayer)" << std::endl;
+}
+
+Mosaic::Mosaic(int boardCount, int screenWidth, int screenHeight, int fieldWidth, int fieldHeight)
+    : fieldWidth(fieldWidth), fieldHeight(fieldHeight), screenHeight(screenHeight), labelScale(1.0f),
+      accumulator(0.0f), revision(0), cubes(nullptr), textRenderer(nullptr) {
+    for (int i = 0; i < boardCount; i++) {
+        Game game{Simulation(fieldWidth, fieldHeight, 1000 + i), Autoplayer::Placement(), 0, 0, false, 0, 0,
+                  static_cast<uint64_t>(1000 + i)};
+        game.simulation.start();
+        games.push_back(game);
+    }
+
+    for (int x = -1; x <= fieldWidth; x++) wallPositions.push_back(glm::vec3(x, -1, 0));
+    for (int y = 0; y <= fieldHeight; y++) {
+        wallPositions.push_back(glm::vec3(-1, y, 0));
+        wallPositions.push_back(glm::vec3(fieldWidth, y, 0));
+    }
+
+    layout(screenWidth, screenHeight);
+    cubes = new CubeInstances();
+    textRenderer = new TextRenderer();
+    textRenderer->setProjection(screenWidth, screenHeight);
+}
+
+Mosaic::~Mosaic() {
+    delete cubes;
+    delete textRenderer;
+}
+
+void Mosaic::resize(int screenWidth, int screenHeight) {
+    if (screenWidth <= 0 || screenHeight <= 0) return;
+    this->screenHeight = screenHeight;
+    origins.clear();
+    labelPositions.clear();
+    layout(screenWidth, screenHeight);
+    textRenderer->setProjection(screenWidth, screenHeight);
+    revision++;
+}
+
+// Grille proche du format de l'écran, caméra reculée pour tout voir
+void Mosaic::layout(int screenWidth, int screenHeight) {
+    float aspect = static_cast<float>(screenWidth) / screenHeight;
+    int pitchX = fieldWidth + 2 + BOARD_GAP;
+    int pitchY = fieldHeight + 2 + LABEL_ROWS;
+    int count = static_cast<int>(games.size());
+    int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(count * aspect * pitchY / pitchX))));
+    columns = std::min(columns, count);
+    int rows = (count + columns - 1) / columns;
+
+    for (int i = 0; i < count; i++) {
+        int column = i % columns;
+        int row = rows - 1 - i / columns;
+        origins.push_back(glm::vec3(column * pitchX, row * pitchY, 0.0f));
+    }
+
+    // Du mur gauche de la première colonne au mur droit de la dernière,
+    // du sol de la rangée du bas au score de la rangée du haut
+    float left = -1.0f;
+    float right = (columns - 1) * pitchX + fieldWidth;
+    float bottom = -1.0f;
+    float top = (rows - 1) * pitchY + fieldHeight + LABEL_ROWS;
+    // Bandeau de l'en-tête en haut de l'écran
+    top += (top - bottom) * HEADER_HEIGHT / screenHeight;
+
+    float halfFov = std::tan(glm::radians(45.0f) * 0.5f);
+    float distance = 1.05f * std::max((top - bottom) * 0.5f / halfFov, (right - left) * 0.5f / (halfFov * aspect));
+    glm::vec3 center((left + right) * 0.5f, (bottom + top) * 0.5f, 0.0f);
+    cameraPosition = center + glm::vec3(0.0f, 0.0f, distance);
+    // Même direction de lumière que la vue d'un seul plateau
+    lightPosition = center + glm::vec3(0.18f, 0.17f, 0.33f) * distance;
+    view = glm::lookAt(cameraPosition, center, glm::vec3(0.0f, 1.0f, 0.0f));
+    projection = glm::perspective(glm::radians(45.0f), aspect, distance * 0.5f, distance + 10.0f);
+
+    // Scores à positions fixes : projetés une fois, au-dessus du mur gauche
+    glm::vec4 viewport(0.0f, 0.0f, static_cast<float>(screenWidth), static_cast<float>(screenHeight));
+    float pixelsPerCube = screenHeight / (2.0f * distance * halfFov);
+    labelScale = std::max(1.0f, std::floor(pixelsPerCube * 0.2f));
+    for (const glm::vec3& origin : origins) {
+        glm::vec3 anchor = glm::project(origin + glm::vec3(-0.5f, fieldHeight + 1.5f, 0.0f), view, projection, viewport);
+        labelPositions.push_back(glm::vec2(anchor.x, anchor.y));
+    }
+}
+
+unsigned long long Mosaic::getGamesPlayed() const {
+    unsigned long long total = 0;
+    for (const Game& game : games) total += game.finished;
+    return total;
+}
+
+void Mosaic::update(float deltaTime) {
+    accumulator += deltaTime;
+    int ticks = static_cast<int>(accumulator / TICK_SECONDS);
+    if (ticks == 0) return;
+    if (ticks > MAX_TICKS_PER_UPDATE) {
+        ticks = MAX_TICKS_PER_UPDATE;
+        accumulator = 0.0f;
+    } else {
+        accumulator -= ticks * TICK_SECONDS;
+    }
+    advance(ticks);
+}
+
+void Mosaic::advance(int ticks) {
+    PROFILE_ZONE("Mosaic::advance");
+    // Un bloc de parties par thread : chaque partie n'est touchée que par un seul
+    size_t threads = std::max(1u, pool.getThreadCount());
+    size_t chunk = (games.size() + threads - 1) / threads;
+    for (size_t first = 0; first < games.size(); first += chunk) {
+        size_t last = std::min(games.size(), first + chunk);
+        pool.submit([this, first, last, ticks] {
+            for (size_t i = first; i < last; i++) {
+                for (int t = 0; t < ticks; t++) tick(games[i]);
+            }
+        });
+    }
+    pool.wait();
+    revision++;
+}
+
+// Même pilotage que l'autoplay du jeu : rotation, déplacement, puis chute rapide
+void Mosaic::tick(Game& game) const {
+    Simulation& simulation = game.simulation;
+    if (simulation.getGameState() != GameState::PLAYING) {
+        game.finished++;
+        simulation.reset(game.seed + game.finished * MAX_BOARDS);
+        simulation.start();
+        game.spawn = 0;
+        return;
+    }
+
+    if (simulation.getSpawnCount() != game.spawn) {
+        game.spawn = simulation.getSpawnCount();
+        game.target = player.findBestPlacement(simulation);
+        game.steps = 0;
+        game.dropping = false;
+    }
+
+    const Piece* piece = simulation.getCurrentPiece();
+    if (!game.dropping) {
+        int x = piece ? static_cast<int>(piece->getX()) : game.target.x;
+        if (!piece || !game.target.valid || game.steps++ > 16) game.dropping = true;
+        else if (piece->getRotation() != game.target.rotation) simulation.rotateCurrentPiece();
+        else if (x < game.target.x) simulation.moveCurrentPiece(1, 0);
+        else if (x > game.target.x) simulation.moveCurrentPiece(-1, 0);
+        else game.dropping = true;
+    }
+
+    if (game.dropping || ++game.gravityTicks >= GRAVITY_TICKS) {
+        simulation.update();
+        game.gravityTicks = 0;
+    }
+}
+
+void Mosaic::collectInstances() {
+    PROFILE_ZONE("Mosaic::collectInstances");
+    const glm::vec3 frameColor(0.6f, 0.6f, 0.65f);
+    instances.clear();
+    labelRects.clear();
+
+    for (size_t i = 0; i < games.size(); i++) {
+        const Simulation& simulation = games[i].simulation;
+        const glm::vec3& origin = origins[i];
+        for (const glm::vec3& wall : wallPositions) instances.push_back(CubeInstance{origin + wall, frameColor});
+
+        const uint8_t* cells = simulation.getCells();
+        for (int y = 0; y < fieldHeight; y++) {
+            for (int x = 0; x < fieldWidth; x++) {
+                uint8_t cell = cells[y * fieldWidth + x];
+                if (cell == 0) continue;
+                glm::vec3 color = Piece::colorFor(static_cast<PieceType>(cell - 1));
+                instances.push_back(CubeInstance{origin + glm::vec3(x, y, 0), color});
+            }
+        }
+
+        const Piece* piece = simulation.getCurrentPiece();
+        if (piece && simulation.getGameState() == GameState::PLAYING) {
+            for (const glm::vec2& block : piece->getBlockPositions()) {
+                instances.push_back(CubeInstance{origin + glm::vec3(block.x, block.y, 0), piece->getColor()});
+            }
+        }
+
+        TextRenderer::appendText(labelRects, std::to_string(simulation.getScore()),
+                                 labelPositions[i].x, labelPositions[i].y, labelScale);
+    }
+
+    std::string header = std::to_string(games.size()) + " PARTIES - " + std::to_string(getGamesPlayed()) + " TERMINEES";
+    TextRenderer::appendText(labelRects, header, 10.0f, screenHeight - HEADER_HEIGHT + 6.0f, 2.0f);
+}
+
+void Mosaic::render() {
+    PROFILE_ZONE("Mosaic::render");
+    collectInstances();
+
+    RenderBackend& backend = RenderBackend::current();
+    cubes->upload(instances);
+    // Contours fins : à 256 parties un cube ne fait que quelques pixels
+    cubes->render(view, projection, lightPosition, cameraPosition, 1.0f);
+
+    backend.setDepthTest(false);
+    textRenderer->renderRects(labelRects, glm::vec3(0.45f, 0.35f, 0.5f));
+    backend.setDepthTest(true);
+}
@@ -0,0 +1,375 @@
+#include "NeuralEvaluator.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const int16_t INPUT_ONE = 64;
+const int16_t ACTIVATION_MAX = 127;
+const char* FILE_MAGIC = "tetris3d-mlp";
+
+int roundUp16(int value) {
+    return (value + 15) & ~15;
+}
+
+// FNV-1a 64 bits
+uint64_t hashBytes(uint64_t h, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        h ^= bytes[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+// Buffers de travail de l'évaluation, un jeu par thread, agrandis au premier
+// lot d'un réseau plus grand puis réutilisés sans allocation
+struct Scratch {
+    std::vector<int16_t> inputs;
+    std::vector<int16_t> hidden;
+    std::vector<int16_t> tile;
+};
+
+Scratch& threadScratch() {
+    thread_local Scratch scratch;
+    return scratch;
+}
+
+int16_t activate(int32_t accumulator, int shift) {
+    if (accumulator <= 0) return 0;
+    return static_cast<int16_t>(std::min<int32_t>(accumulator >> shift, ACTIVATION_MAX));
+}
+
+// Noyau par tuiles : les voies d'un registre sont des plateaux différents.
+// Les entrées d'une tuile sont entrelacées par paires ([paire][plateau][2]),
+// si bien qu'une paire de poids diffusée dans tout le registre et un seul
+// madd avancent les produits de plusieurs plateaux à la fois : chaque ligne
+// de poids est lue une fois par tuile et aucune réduction horizontale n'est
+// nécessaire.
+#if defined(__AVX2__)
+typedef __m256i Lanes;
+const int LANE_COUNT = 8;
+
+inline Lanes loadLanes(const int16_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+inline void storeLanes(int32_t* p, Lanes v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+inline Lanes broadcast(int32_t value) { return _mm256_set1_epi32(value); }
+inline Lanes addLanes(Lanes a, Lanes b) { return _mm256_add_epi32(a, b); }
+inline Lanes maddLanes(Lanes a, Lanes b) { return _mm256_madd_epi16(a, b); }
+
+// Les quatre paires de poids de pairs[0..7], chacune diffusée dans tout un registre
+inline void broadcastPairs(const int16_t* pairs, Lanes out[4]) {
+    for (int j = 0; j < 4; j++) {
+        int32_t pair;
+        std::memcpy(&pair, pairs + 2 * j, sizeof(pair));
+        out[j] = _mm256_set1_epi32(pair);
+    }
+}
+
+// activate() sur chaque voie : décalage arithmétique puis bornage à [0, ACTIVATION_MAX]
+inline Lanes activateLanes(Lanes accumulator, int shift) {
+    Lanes shifted = _mm256_sra_epi32(accumulator, _mm_cvtsi32_si128(shift));
+    return _mm256_min_epi32(_mm256_max_epi32(shifted, _mm256_setzero_si256()), _mm256_set1_epi32(ACTIVATION_MAX));
+}
+#elif defined(__SSE2__)
+typedef __m128i Lanes;
+const int LANE_COUNT = 4;
+
+inline Lanes loadLanes(const int16_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline void storeLanes(int32_t* p, Lanes v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+inline Lanes broadcast(int32_t value) { return _mm_set1_epi32(value); }
+inline Lanes addLanes(Lanes a, Lanes b) { return _mm_add_epi32(a, b); }
+inline Lanes maddLanes(Lanes a, Lanes b) { return _mm_madd_epi16(a, b); }
+
+// Une lecture pour quatre paires de poids, puis un pshufd par paire
+inline void broadcastPairs(const int16_t* pairs, Lanes out[4]) {
+    Lanes loaded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pairs));
+    out[0] = _mm_shuffle_epi32(loaded, _MM_SHUFFLE(0, 0, 0, 0));
+    out[1] = _mm_shuffle_epi32(loaded, _MM_SHUFFLE(1, 1, 1, 1));
+    out[2] = _mm_shuffle_epi32(loaded, _MM_SHUFFLE(2, 2, 2, 2));
+    out[3] = _mm_shuffle_epi32(loaded, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+// SSE2 n'a ni min ni max sur 32 bits : bornage par comparaisons et masques
+inline Lanes activateLanes(Lanes accumulator, int shift) {
+    Lanes shifted = _mm_sra_epi32(accumulator, _mm_cvtsi32_si128(shift));
+    Lanes positive = _mm_and_si128(shifted, _mm_cmpgt_epi32(shifted, _mm_setzero_si128()));
+    Lanes limit = _mm_set1_epi32(ACTIVATION_MAX);
+    Lanes over = _mm_cmpgt_epi32(positive, limit);
+    return _mm_or_si128(_mm_andnot_si128(over, positive), _mm_and_si128(over, limit));
+}
+#endif
+
+}
+
+NeuralEvaluator::NeuralEvaluator()
+    : boardWidth(0), boardHeight(0), inputs(0), paddedInputs(0), hidden(0), shift(6),
+      outputScale(1.0f), useSimd(simdAvailable()), bias2(0), fingerprint(0) {}
+
+bool NeuralEvaluator::simdAvailable() {
+#if defined(__AVX2__) || defined(__SSE2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* NeuralEvaluator::simdName() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "aucun";
+#endif
+}
+
+void NeuralEvaluator::allocate(int width, int height, int hiddenCount) {
+    boardWidth = width;
+    boardHeight = height;
+    inputs = width * height + width;
+    paddedInputs = roundUp16(inputs);
+    hidden = hiddenCount;
+
+    // Les colonnes et lignes de remplissage restent à zéro
+    int paddedHidden = roundUp16(hidden);
+    weights1.assign(static_cast<size_t>(hidden) * paddedInputs, 0);
+    bias1.assign(hidden, 0);
+    weights2.assign(paddedHidden, 0);
+    bias2 = 0;
+}
+
+void NeuralEvaluator::updateFingerprint() {
+    const int header[] = {boardWidth, boardHeight, hidden, shift};
+    uint64_t h = hashBytes(0xCBF29CE484222325ULL, header, sizeof(header));
+    h = hashBytes(h, &outputScale, sizeof(outputScale));
+    h = hashBytes(h, weights1.data(), weights1.size() * sizeof(int16_t));
+    h = hashBytes(h, bias1.data(), bias1.size() * sizeof(int32_t));
+    h = hashBytes(h, weights2.data(), weights2.size() * sizeof(int16_t));
+    fingerprint = hashBytes(h, &bias2, sizeof(bias2));
+}
+
+bool NeuralEvaluator::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cout << "Impossible d'ouvrir les poids du réseau : " << path << std::endl;
+        return false;
+    }
+
+    std::string magic;
+    int version = 0;
+    std::string key;
+    int width = 0, height = 0, hiddenCount = 0, fileShift = 0;
+    float scale = 0.0f;
+    in >> magic >> version;
+    in >> key >> width >> height;
+    bool ok = magic == FILE_MAGIC && version == 1 && key == "board";
+    in >> key >> hiddenCount;
+    ok = ok && key == "hidden";
+    in >> key >> fileShift;
+    ok = ok && key == "shift";
+    in >> key >> scale;
+    ok = ok && key == "output_scale";
+    ok = ok && in && width > 0 && height > 0 && hiddenCount > 0 && fileShift >= 0 && fileShift < 31;
+    if (!ok) {
+        std::cout << "En-tête de poids invalide : " << path << std::endl;
+        return false;
+    }
+
+    NeuralEvaluator loaded;
+    loaded.allocate(width, height, hiddenCount);
+    loaded.shift = fileShift;
+    loaded.outputScale = scale;
+
+    auto readWeight = [&in](int16_t& out) {
+        int value;
+        if (!(in >> value) || value < -128 || value > 127) return false;
+        out = static_cast<int16_t>(value);
+        return true;
+    };
+
+    for (int h = 0; h < hiddenCount && ok; h++) {
+        for (int i = 0; i < loaded.inputs && ok; i++) {
+            ok = readWeight(loaded.weights1[static_cast<size_t>(h) * loaded.paddedInputs + i]);
+        }
+        ok = ok && static_cast<bool>(in >> loaded.bias1[h]);
+    }
+    for (int h = 0; h < hiddenCount && ok; h++) ok = readWeight(loaded.weights2[h]);
+    ok = ok && static_cast<bool>(in >> loaded.bias2);
+
+    if (!ok) {
+        std::cout << "Poids du réseau incomplets ou hors limites : " << path << std::endl;
+        return false;
+    }
+
+    loaded.useSimd = useSimd;
+    loaded.updateFingerprint();
+    *this = loaded;
+    return true;
+}
+
+bool NeuralEvaluator::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out || !isLoaded()) return false;
+
+    out << FILE_MAGIC << " 1\n";
+    out << "board " << boardWidth << ' ' << boardHeight << '\n';
+    out << "hidden " << hidden << '\n';
+    out << "shift " << shift << '\n';
+    out << "output_scale " << outputScale << '\n';
+    for (int h = 0; h < hidden; h++) {
+        for (int i = 0; i < inputs; i++) {
+            out << weights1[static_cast<size_t>(h) * paddedInputs + i] << ' ';
+        }
+        out << bias1[h] << '\n';
+    }
+    for (int h = 0; h < hidden; h++) out << weights2[h] << ' ';
+    out << bias2 << '\n';
+    return static_cast<bool>(out);
+}
+
+NeuralEvaluator NeuralEvaluator::createRandom(int width, int height, int hiddenCount, uint64_t seed) {
+    NeuralEvaluator evaluator;
+    evaluator.allocate(width, height, hiddenCount);
+    evaluator.shift = 6;
+    evaluator.outputScale = 1.0f / 64.0f;
+
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> weight(-32, 32);
+    std::uniform_int_distribution<int> bias(-256, 256);
+    for (int h = 0; h < hiddenCount; h++) {
+        for (int i = 0; i < evaluator.inputs; i++) {
+            evaluator.weights1[static_cast<size_t>(h) * evaluator.paddedInputs + i] =
+                static_cast<int16_t>(weight(rng));
+        }
+        evaluator.bias1[h] = bias(rng);
+        evaluator.weights2[h] = static_cast<int16_t>(weight(rng));
+    }
+    evaluator.bias2 = bias(rng);
+    evaluator.updateFingerprint();
+    return evaluator;
+}
+
+// Entrée i écrite en input[(i / 2) * pairStride + i % 2] : pairStride vaut 2
+// pour un plateau contigu, 2 * TILE pour un plateau d'une tuile entrelacée
+void NeuralEvaluator::buildInputs(const uint8_t* cells, int16_t* input, int pairStride) const {
+    auto at = [input, pairStride](int i) -> int16_t& { return input[(i >> 1) * pairStride + (i & 1)]; };
+    int cellCount = boardWidth * boardHeight;
+    for (int i = 0; i < cellCount; i++) {
+        at(i) = cells[i] != 0 ? INPUT_ONE : 0;
+    }
+
+    for (int x = 0; x < boardWidth; x++) {
+        int columnHeight = 0;
+        for (int y = boardHeight - 1; y >= 0; y--) {
+            if (cells[y * boardWidth + x] != 0) {
+                columnHeight = y + 1;
+                break;
+            }
+        }
+        at(cellCount + x) = static_cast<int16_t>(std::min(columnHeight, static_cast<int>(ACTIVATION_MAX)));
+    }
+    // Remplissage à zéro : le buffer du thread a pu servir à un réseau d'une autre taille
+    for (int i = inputs; i < paddedInputs; i++) at(i) = 0;
+}
+
+int32_t NeuralEvaluator::forwardScalar(const int16_t* input, int16_t* hiddenOut) const {
+    for (int h = 0; h < hidden; h++) {
+        const int16_t* row = weights1.data() + static_cast<size_t>(h) * paddedInputs;
+        int32_t accumulator = bias1[h];
+        for (int i = 0; i < paddedInputs; i++) accumulator += row[i] * input[i];
+        hiddenOut[h] = activate(accumulator, shift);
+    }
+
+    int32_t output = bias2;
+    for (int h = 0; h < hidden; h++) output += weights2[h] * hiddenOut[h];
+    return output;
+}
+
+// tile : entrées de TILE plateaux entrelacées par paires, outputs : TILE sorties
+void NeuralEvaluator::forwardSimd(const int16_t* tile, int32_t* outputs) const {
+#if defined(__AVX2__) || defined(__SSE2__)
+    const int VECTORS = TILE / LANE_COUNT;
+    Lanes output[VECTORS];
+    for (int v = 0; v < VECTORS; v++) output[v] = broadcast(bias2);
+
+    int pairs = paddedInputs / 2;
+    for (int h = 0; h < hidden; h++) {
+        const int16_t* row = weights1.data() + static_cast<size_t>(h) * paddedInputs;
+        Lanes accumulator[VECTORS];
+        for (int v = 0; v < VECTORS; v++) accumulator[v] = broadcast(bias1[h]);
+
+        // paddedInputs est multiple de 16 : les paires vont par quatre
+        const int16_t* input = tile;
+        for (int k = 0; k < pairs; k += 4) {
+            Lanes weights[4];
+            broadcastPairs(row + 2 * k, weights);
+            for (int j = 0; j < 4; j++, input += TILE * 2) {
+                for (int v = 0; v < VECTORS; v++) {
+                    accumulator[v] = addLanes(accumulator[v],
+                                              maddLanes(weights[j], loadLanes(input + v * LANE_COUNT * 2)));
+                }
+            }
+        }
+
+        // Activations entre 0 et 127 : le poids de sortie, étendu sans signe
+        // sur 32 bits, ne multiplie que leur moitié basse dans madd
+        Lanes weight = broadcast(static_cast<uint16_t>(weights2[h]));
+        for (int v = 0; v < VECTORS; v++) {
+            output[v] = addLanes(output[v], maddLanes(activateLanes(accumulator[v], shift), weight));
+        }
+    }
+    for (int v = 0; v < VECTORS; v++) storeLanes(outputs + v * LANE_COUNT, output[v]);
+#else
+    (void)tile;
+    (void)outputs;
+#endif
+}
+
+void NeuralEvaluator::evaluateBatch(const uint8_t* boards, int count, float* scores) const {
+    int cellCount = boardWidth * boardHeight;
+    count = std::min(count, static_cast<int>(MAX_BATCH));
+    Scratch& scratch = threadScratch();
+
+    if (!useSimd || !simdAvailable()) {
+        if (scratch.inputs.size() < static_cast<size_t>(paddedInputs)) scratch.inputs.resize(paddedInputs);
+        if (scratch.hidden.size() < static_cast<size_t>(hidden)) scratch.hidden.resize(hidden);
+        for (int b = 0; b < count; b++) {
+            buildInputs(boards + static_cast<size_t>(b) * cellCount, scratch.inputs.data(), 2);
+            scores[b] = forwardScalar(scratch.inputs.data(), scratch.hidden.data()) * outputScale;
+        }
+        return;
+    }
+
+    // Tuiles de TILE plateaux, entrées écrites directement entrelacées ; les
+    // voies au-delà de count calculent des plateaux vides, ignorés
+    size_t tileSize = static_cast<size_t>(TILE) * paddedInputs;
+    if (scratch.tile.size() < tileSize) scratch.tile.resize(tileSize);
+    for (int first = 0; first < count; first += TILE) {
+        int tileCount = std::min(static_cast<int>(TILE), count - first);
+        for (int b = 0; b < tileCount; b++) {
+            buildInputs(boards + static_cast<size_t>(first + b) * cellCount, scratch.tile.data() + b * 2, TILE * 2);
+        }
+        for (int b = tileCount; b < TILE; b++) {
+            int16_t* target = scratch.tile.data() + b * 2;
+            for (int i = 0; i < paddedInputs; i += 2, target += TILE * 2) target[0] = target[1] = 0;
+        }
+        int32_t outputs[TILE];
+        forwardSimd(scratch.tile.data(), outputs);
+        for (int b = 0; b < tileCount; b++) scores[first + b] = outputs[b] * outputScale;
+    }
+}
+
+float NeuralEvaluator::evaluate(const uint8_t* cells) const {
+    float score;
+    evaluateBatch(cells, 1, &score);
+    return score;
+}
\ No newline at end of file
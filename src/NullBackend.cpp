@@ -0,0 +1,133 @@
+#include "NullBackend.h"
+#include <glm/gtc/type_ptr.hpp>
+
+NullBackend::NullBackend() : nextObject(1), stream(0), streamUsed(0) {
+    commands.reserve(4096);
+    uniformValues.reserve(16384);
+}
+
+void NullBackend::clear() {
+    commands.clear();
+    uniformValues.clear();
+}
+
+size_t NullBackend::getCount(CommandType type) const {
+    size_t count = 0;
+    for (const Command& command : commands) {
+        if (command.type == type) count++;
+    }
+    return count;
+}
+
+void NullBackend::record(CommandType type, unsigned int object, size_t size) {
+    commands.push_back(Command{type, object, size});
+}
+
+unsigned int NullBackend::createVertexArray() {
+    return nextObject++;
+}
+
+unsigned int NullBackend::createBuffer() {
+    return nextObject++;
+}
+
+unsigned int NullBackend::createProgram(const char*, const char*) {
+    return nextObject++;
+}
+
+unsigned int NullBackend::createTexture() {
+    return nextObject++;
+}
+
+void NullBackend::bindVertexArray(unsigned int vertexArray) {
+    record(CommandType::BIND_VERTEX_ARRAY, vertexArray, 0);
+}
+
+void NullBackend::bindBuffer(BufferTarget target, unsigned int buffer) {
+    record(CommandType::BIND_BUFFER, buffer, static_cast<size_t>(target));
+}
+
+void NullBackend::bufferData(BufferTarget, size_t size, const void*, BufferUsage) {
+    record(CommandType::BUFFER_DATA, 0, size);
+}
+
+void NullBackend::bufferSubData(BufferTarget, size_t, size_t size, const void*) {
+    record(CommandType::BUFFER_SUB_DATA, 0, size);
+}
+
+size_t NullBackend::streamData(const void*, size_t size, size_t alignment) {
+    size_t offset = (streamUsed + alignment - 1) / alignment * alignment;
+    streamUsed = offset + size;
+    record(CommandType::STREAM_DATA, 0, size);
+    return offset;
+}
+
+unsigned int NullBackend::streamBuffer() {
+    if (stream == 0) stream = nextObject++;
+    return stream;
+}
+
+void NullBackend::vertexAttribute(unsigned int index, int components, size_t, size_t) {
+    record(CommandType::VERTEX_ATTRIBUTE, index, components);
+}
+
+void NullBackend::instanceAttribute(unsigned int index, int components, size_t, size_t) {
+    record(CommandType::INSTANCE_ATTRIBUTE, index, components);
+}
+
+void NullBackend::bindTexture(int unit, unsigned int texture) {
+    record(CommandType::BIND_TEXTURE, texture, unit);
+}
+
+void NullBackend::textureImage(int width, int height, const void*) {
+    record(CommandType::TEXTURE_IMAGE, 0, static_cast<size_t>(width) * height);
+}
+
+void NullBackend::textureSubImage(int firstRow, int width, int rows, const void*) {
+    record(CommandType::TEXTURE_SUB_IMAGE, firstRow, static_cast<size_t>(width) * rows);
+}
+
+void NullBackend::useProgram(unsigned int program) {
+    record(CommandType::USE_PROGRAM, program, 0);
+}
+
+void NullBackend::setUniform(unsigned int program, const char*, const glm::mat4& value) {
+    record(CommandType::SET_UNIFORM, program, uniformValues.size());
+    const float* values = glm::value_ptr(value);
+    uniformValues.insert(uniformValues.end(), values, values + 16);
+}
+
+void NullBackend::setUniform(unsigned int program, const char*, const glm::vec3& value) {
+    record(CommandType::SET_UNIFORM, program, uniformValues.size());
+    uniformValues.insert(uniformValues.end(), {value.x, value.y, value.z});
+}
+
+void NullBackend::setUniform(unsigned int program, const char*, int value) {
+    record(CommandType::SET_UNIFORM, program, uniformValues.size());
+    uniformValues.push_back(static_cast<float>(value));
+}
+
+void NullBackend::setUniform(unsigned int program, const char*, float value) {
+    record(CommandType::SET_UNIFORM, program, uniformValues.size());
+    uniformValues.push_back(value);
+}
+
+void NullBackend::setDepthTest(bool enabled) {
+    record(CommandType::SET_DEPTH_TEST, enabled ? 1 : 0, 0);
+}
+
+void NullBackend::drawArrays(Primitive primitive, int, int count) {
+    record(CommandType::DRAW_ARRAYS, static_cast<unsigned int>(primitive), count);
+}
+
+void NullBackend::drawElements(Primitive primitive, int count) {
+    record(CommandType::DRAW_ELEMENTS, static_cast<unsigned int>(primitive), count);
+}
+
+void NullBackend::drawElementsInstanced(Primitive primitive, int count, int instances) {
+    record(CommandType::DRAW_ELEMENTS_INSTANCED, static_cast<unsigned int>(primitive), static_cast<size_t>(count) * instances);
+}
+
+void NullBackend::multiDrawElementsIndirect(Primitive primitive, size_t, int drawCount) {
+    record(CommandType::MULTI_DRAW_ELEMENTS_INDIRECT, static_cast<unsigned int>(primitive), drawCount);
+}
@@ -0,0 +1,102 @@
+#include "PerfOverlay.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const float GRAPH_WIDTH = 240.0f;
+const float GRAPH_HEIGHT = 80.0f;
+// Le haut du graphe correspond à deux images à 60 Hz
+const float GRAPH_MAX_MS = 33.3f;
+const float TARGET_MS = 1000.0f / 60.0f;
+
+std::string formatMs(const char* label, float ms) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%-6s%5.2f ms", label, ms);
+    return buffer;
+}
+
+}
+
+PerfOverlay::PerfOverlay()
+    : head(0), count(0), lastFrameMs(0.0f), lastCpuMs(0.0f), gpuValid(false), gpuTotalMs(0.0f),
+      resolutionScale(0.0f), tableHitRate(-1.0f), tableOccupancy(-1.0f) {
+    std::fill(frameHistory, frameHistory + HISTORY, 0.0f);
+    std::fill(gpuHistory, gpuHistory + HISTORY, 0.0f);
+    std::fill(gpuPassMs, gpuPassMs + GpuTimer::PASS_COUNT, 0.0f);
+}
+
+void PerfOverlay::addSample(float frameMs, float cpuMs, const GpuTimer& timer) {
+    lastFrameMs = frameMs;
+    lastCpuMs = cpuMs;
+    gpuValid = timer.hasResults();
+    for (int p = 0; p < GpuTimer::PASS_COUNT; p++) {
+        gpuPassMs[p] = timer.getPassMs(static_cast<GpuTimer::Pass>(p));
+    }
+    gpuTotalMs = timer.getTotalMs();
+
+    frameHistory[head] = frameMs;
+    gpuHistory[head] = gpuValid ? gpuTotalMs : 0.0f;
+    head = (head + 1) % HISTORY;
+    count = std::min(count + 1, static_cast<int>(HISTORY));
+}
+
+void PerfOverlay::render(TextRenderer& text, float x, float y) const {
+    glm::vec3 background(0.2f, 0.18f, 0.22f);
+    glm::vec3 frameColor(0.95f, 0.7f, 0.5f);
+    glm::vec3 gpuColor(0.45f, 0.65f, 0.75f);
+    glm::vec3 lineColor(0.5f, 0.75f, 0.6f);
+    glm::vec3 labelColor(0.5f, 0.5f, 0.55f);
+
+    text.renderRect(x, y, GRAPH_WIDTH, GRAPH_HEIGHT, background);
+
+    // Une barre par image, la plus récente à droite ; le temps GPU par-dessus
+    float barWidth = GRAPH_WIDTH / HISTORY;
+    std::vector<glm::vec4> frameBars;
+    std::vector<glm::vec4> gpuBars;
+    frameBars.reserve(count);
+    gpuBars.reserve(count);
+    for (int i = 0; i < count; i++) {
+        int index = (head - count + i + HISTORY) % HISTORY;
+        float barX = x + (HISTORY - count + i) * barWidth;
+        float frameHeight = std::min(frameHistory[index] / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+        float gpuHeight = std::min(gpuHistory[index] / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+        frameBars.push_back(glm::vec4(barX, y, barWidth, frameHeight));
+        if (gpuHeight > 0.0f) gpuBars.push_back(glm::vec4(barX, y, barWidth, gpuHeight));
+    }
+    text.renderRects(frameBars, frameColor);
+    text.renderRects(gpuBars, gpuColor);
+    text.renderRect(x, y + TARGET_MS / GRAPH_MAX_MS * GRAPH_HEIGHT, GRAPH_WIDTH, 1.0f, lineColor);
+
+    float scale = 2.0f;
+    float lineHeight = 20.0f;
+    float textY = y + GRAPH_HEIGHT + 10.0f;
+    for (int p = GpuTimer::PASS_COUNT - 1; p >= 0; p--) {
+        std::string label = gpuValid ? formatMs(GpuTimer::passName(static_cast<GpuTimer::Pass>(p)), gpuPassMs[p])
+                                     : std::string(GpuTimer::passName(static_cast<GpuTimer::Pass>(p))) + "  --";
+        text.queueText(label, x + 24.0f, textY, scale, gpuColor);
+        textY += lineHeight;
+    }
+    text.queueText(gpuValid ? formatMs("GPU", gpuTotalMs) : "GPU   --", x, textY, scale, gpuColor);
+    textY += lineHeight;
+    text.queueText(formatMs("CPU", lastCpuMs), x, textY, scale, labelColor);
+    textY += lineHeight;
+    text.queueText(formatMs("FRAME", lastFrameMs), x, textY, scale, frameColor);
+    if (resolutionScale > 0.0f) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%-6s%5.0f %%", "SCALE", resolutionScale * 100.0f);
+        textY += lineHeight;
+        text.queueText(buffer, x, textY, scale, labelColor);
+    }
+    if (tableHitRate >= 0.0f) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%-6s%5.1f %%", "TT HIT", tableHitRate * 100.0f);
+        textY += lineHeight;
+        text.queueText(buffer, x, textY, scale, labelColor);
+        std::snprintf(buffer, sizeof(buffer), "%-6s%5.1f %%", "TT OCC", tableOccupancy * 100.0f);
+        textY += lineHeight;
+        text.queueText(buffer, x, textY, scale, labelColor);
+    }
+    text.flush();
+}
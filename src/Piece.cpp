@@ -12,14 +12,13 @@ static const glm::vec3 PIECE_COLORS[] = {
     glm::vec3(1.0f, 0.75f, 0.5f)   
 };
 
-Piece::Piece(PieceType type, float x, float y) : type(type), x(x), y(y) {
-    color = PIECE_COLORS[static_cast<int>(type)];
+Piece::Piece(PieceType type, float x, float y) : type(type), x(x), y(y), rotation(0) {
+    color = colorFor(type);
     initializePiece(type);
-    updateCubePositions();
 }
 
-Piece::~Piece() {
-    for (Cube* cube : cubes) delete cube;
+glm::vec3 Piece::colorFor(PieceType type) {
+    return PIECE_COLORS[static_cast<int>(type)];
 }
 
 void Piece::initializePiece(PieceType type) {
@@ -34,18 +33,6 @@ void Piece::initializePiece(PieceType type) {
         case PieceType::L: shape = {{0, 0}, {0, 1}, {0, -1}, {1, -1}}; break;
         default: shape = {{-2, 0}, {-1, 0}, {0, 0}, {1, 0}}; break;
     }
-    
-    // On crée un cube pour chaque bloc de la pièce
-    for (size_t i = 0; i < shape.size(); i++) {
-        cubes.push_back(new Cube(0, 0, 0, color));
-    }
-}
-
-void Piece::updateCubePositions() {
-    for (size_t i = 0; i < cubes.size(); i++) {
-        cubes[i]->setPosition(x + shape[i].x, y + shape[i].y, 0);
-        cubes[i]->setColor(color);
-    }
 }
 
 void Piece::rotate() {
@@ -56,23 +43,17 @@ void Piece::rotate() {
     }
     
     shape = newShape;
-    updateCubePositions();
-}
-
-void Piece::render(const glm::mat4& view, const glm::mat4& projection) {
-    for (Cube* cube : cubes) cube->render(view, projection);
+    rotation = (rotation + 1) % 4;
 }
 
 void Piece::move(float dx, float dy) {
     x += dx;
     y += dy;
-    updateCubePositions();
 }
 
 void Piece::setPosition(float x, float y) {
     this->x = x;
     this->y = y;
-    updateCubePositions();
 }
 
 
@@ -0,0 +1,104 @@
+#include "Ponderer.h"
+#include "Profiler.h"
+
+Ponderer::Ponderer(const Autoplayer::Weights& weights, int depth, int speculation)
+    : table(8), player(weights, depth), speculation(speculation), hasPending(false),
+      stopping(false), generation(0), readyOnSubmit(0), submitCount(0) {
+    player.setTranspositionTable(&table);
+    worker = std::thread(&Ponderer::workerLoop, this);
+}
+
+Ponderer::~Ponderer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+uint64_t Ponderer::keyFor(const Simulation& state) {
+    PieceType pieces[Simulation::QUEUE_SIZE + 1];
+    int count = 0;
+    if (state.getCurrentPiece()) pieces[count++] = state.getCurrentPiece()->getType();
+    for (int i = 0; i < Simulation::QUEUE_SIZE; i++) pieces[count++] = state.getQueuedPiece(i);
+    return TranspositionTable::hashPosition(state.getCells(), state.getWidth(), state.getHeight(),
+                                            pieces, count);
+}
+
+uint64_t Ponderer::submit(const Simulation& state) {
+    uint64_t key = keyFor(state);
+    submitCount++;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Autoplayer::Placement placement;
+    if (findResult(key, placement)) readyOnSubmit++;
+
+    // Le travail en cours sur une autre branche devient inutile
+    generation++;
+    pending = state;
+    hasPending = true;
+    wake.notify_one();
+    return key;
+}
+
+bool Ponderer::getResult(uint64_t key, Autoplayer::Placement& placement) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return findResult(key, placement);
+}
+
+bool Ponderer::findResult(uint64_t key, Autoplayer::Placement& placement) const {
+    for (const auto& result : results) {
+        if (result.first == key) {
+            placement = result.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Ponderer::storeResult(uint64_t key, const Autoplayer::Placement& placement) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Autoplayer::Placement existing;
+    if (findResult(key, existing)) return;
+    results.emplace_back(key, placement);
+    if (results.size() > MAX_RESULTS) results.pop_front();
+}
+
+void Ponderer::workerLoop() {
+    PROFILE_THREAD_NAME("ponderer");
+    while (true) {
+        Simulation state;
+        unsigned long long startGeneration;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || hasPending; });
+            if (stopping) return;
+            state = pending;
+            hasPending = false;
+            startGeneration = generation.load();
+        }
+
+        PROFILE_ZONE("Ponderer::search");
+        for (int step = 0; step <= speculation; step++) {
+            if (state.getGameState() != GameState::PLAYING) break;
+
+            uint64_t key = keyFor(state);
+            Autoplayer::Placement placement;
+            bool cached;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                cached = findResult(key, placement);
+            }
+            if (!cached) {
+                table.newSearch();
+                placement = player.findBestPlacement(state);
+                storeResult(key, placement);
+            }
+
+            // Une nouvelle soumission rend la suite de cette branche caduque
+            if (generation.load() != startGeneration) break;
+            player.applyPlacement(state, placement);
+        }
+    }
+}
\ No newline at end of file
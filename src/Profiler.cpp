@@ -0,0 +1,142 @@
+#include "Profiler.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+};
+
+struct ThreadBuffer {
+    std::unique_ptr<Event[]> events{new Event[Profiler::EVENTS_PER_THREAD]};
+    // Nombre total d'événements écrits ; seul le thread propriétaire l'incrémente
+    std::atomic<uint64_t> head{0};
+    std::atomic<const char*> name{nullptr};
+    int id = 0;
+};
+
+// Les buffers ne sont jamais libérés : ceux des threads terminés restent exportables
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+ThreadBuffer* registerThread() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.emplace_back(new ThreadBuffer());
+    registry.back()->id = static_cast<int>(registry.size());
+    return registry.back().get();
+}
+
+// Initialisation constante : pas de garde d'initialisation TLS à chaque zone
+thread_local ThreadBuffer* threadBuffer = nullptr;
+
+ThreadBuffer& localBuffer() {
+    if (!threadBuffer) threadBuffer = registerThread();
+    return *threadBuffer;
+}
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+void writeEscaped(std::ostream& out, const char* text) {
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        out << *c;
+    }
+}
+
+}
+
+uint64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t end) {
+    ThreadBuffer& buffer = localBuffer();
+    uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[index % EVENTS_PER_THREAD] = Event{name, start, end};
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const char* name) {
+    localBuffer().name.store(name, std::memory_order_release);
+}
+
+bool Profiler::isEnabled() {
+#ifdef TETRIS3D_PROFILER
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool Profiler::dumpChromeTrace(const std::string& path) {
+    if (!isEnabled()) {
+        std::cout << "Profileur désactivé à la compilation (TETRIS3D_PROFILER)" << std::endl;
+        return false;
+    }
+
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (auto& buffer : registry) buffers.push_back(buffer.get());
+    }
+
+    std::ofstream out(path);
+    if (!out) {
+        std::cout << "Impossible d'écrire la trace : " << path << std::endl;
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    size_t written = 0;
+    std::vector<Event> snapshot;
+
+    for (ThreadBuffer* buffer : buffers) {
+        const char* threadName = buffer->name.load(std::memory_order_acquire);
+        if (threadName) {
+            out << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+                << buffer->id << ",\"args\":{\"name\":\"";
+            writeEscaped(out, threadName);
+            out << "\"}}";
+            first = false;
+        }
+
+        // Copie puis relecture de la tête : les entrées que l'écrivain a pu
+        // écraser pendant la copie sont écartées
+        uint64_t headBefore = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = headBefore > EVENTS_PER_THREAD ? headBefore - EVENTS_PER_THREAD : 0;
+        snapshot.clear();
+        for (uint64_t i = begin; i < headBefore; i++) {
+            snapshot.push_back(buffer->events[i % EVENTS_PER_THREAD]);
+        }
+        uint64_t headAfter = buffer->head.load(std::memory_order_acquire);
+        // L'écrivain remplit events[headAfter % N] avant de publier headAfter + 1 :
+        // l'entrée headAfter - N peut être à moitié écrasée
+        uint64_t firstValid = headAfter >= EVENTS_PER_THREAD ? headAfter - EVENTS_PER_THREAD + 1 : 0;
+        size_t skip = firstValid > begin ? static_cast<size_t>(firstValid - begin) : 0;
+
+        for (size_t i = skip; i < snapshot.size(); i++) {
+            const Event& event = snapshot[i];
+            out << (first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":\"";
+            writeEscaped(out, event.name);
+            out << "\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"ts\":" << event.start / 1000.0
+                << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+            first = false;
+            written++;
+        }
+    }
+    out << "\n]}\n";
+
+    std::cout << "Trace écrite dans " << path << " (" << written << " zones)" << std::endl;
+    return static_cast<bool>(out);
+}
\ No newline at end of file
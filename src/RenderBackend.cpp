@@ -0,0 +1,17 @@
+#include "RenderBackend.h"
+#include "GlBackend.h"
+
+namespace {
+
+GlBackend glBackend;
+RenderBackend* currentBackend = &glBackend;
+
+}
+
+RenderBackend& RenderBackend::current() {
+    return *currentBackend;
+}
+
+void RenderBackend::setCurrent(RenderBackend* backend) {
+    currentBackend = backend ? backend : &glBackend;
+}
@@ -0,0 +1,26 @@
+#include "RenderScheduler.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+
+RenderScheduler::RenderScheduler(GLFWwindow* window)
+    : window(window), renderedRevision(0), redrawRequested(true), continuous(false) {}
+
+bool RenderScheduler::shouldRender(unsigned revision) const {
+    // Fenêtre réduite : rien n'est visible, la simulation continue sans rendu
+    if (glfwGetWindowAttrib(window, GLFW_ICONIFIED)) return false;
+    return continuous || redrawRequested || revision != renderedRevision;
+}
+
+void RenderScheduler::rendered(unsigned revision) {
+    renderedRevision = revision;
+    redrawRequested = false;
+}
+
+void RenderScheduler::waitEvents(double timeout, unsigned revision) {
+    if (timeout < 0.0) timeout = MAX_IDLE_SECONDS;
+    if (shouldRender(revision) || timeout == 0.0) {
+        glfwPollEvents();
+        return;
+    }
+    glfwWaitEventsTimeout(std::min(timeout, MAX_IDLE_SECONDS));
+}
@@ -0,0 +1,208 @@
+#include "ShaderCache.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const char CACHE_MAGIC[8] = {'T', '3', 'D', 'P', 'R', 'O', 'G', '1'};
+
+struct FileHeader {
+    char magic[8];
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+    uint64_t checksum;
+};
+
+ShaderCache::Stats stats;
+std::string directory;
+bool directoryResolved = false;
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t hashString(uint64_t hash, const char* text) {
+    // Le zéro final sépare les champs : "ab"+"c" et "a"+"bc" diffèrent
+    return fnv1a(hash, text ? text : "", text ? std::strlen(text) + 1 : 1);
+}
+
+uint64_t programKey(const char* vertexSource, const char* fragmentSource) {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = hashString(hash, vertexSource);
+    hash = hashString(hash, fragmentSource);
+    hash = hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hash = hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hash = hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    return hash;
+}
+
+const std::string& cacheDirectory() {
+    if (directoryResolved) return directory;
+    directoryResolved = true;
+    if (const char* path = std::getenv("TETRIS3D_SHADER_CACHE")) {
+        directory = std::string(path) == "off" ? "" : path;
+    } else if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        directory = std::string(xdg) + "/tetris3d";
+    } else if (const char* home = std::getenv("HOME")) {
+        directory = std::string(home) + "/.cache/tetris3d";
+    } else if (const char* local = std::getenv("LOCALAPPDATA")) {
+        directory = std::string(local) + "/tetris3d";
+    } else {
+        directory = "shader_cache";
+    }
+    return directory;
+}
+
+std::string entryPath(uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return cacheDirectory() + "/" + name;
+}
+
+bool binariesSupported() {
+    if (!glad_glProgramBinary || !glad_glGetProgramBinary || !glad_glProgramParameteri) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint ok = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        std::cout << "Erreur de compilation du shader : " << log << std::endl;
+    }
+    return shader;
+}
+
+GLuint linkProgram(const char* vertexSource, const char* fragmentSource, bool retrievable) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+
+    GLuint program = glCreateProgram();
+    if (retrievable) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        std::cout << "Erreur d'édition de liens du programme : " << log << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+GLuint loadBinary(uint64_t key) {
+    std::ifstream in(entryPath(key), std::ios::binary);
+    if (!in) return 0;
+
+    FileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return 0;
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.key != key) return 0;
+
+    std::vector<char> binary(header.length);
+    if (!in.read(binary.data(), binary.size())) return 0;
+    if (fnv1a(14695981039346656037ULL, binary.data(), binary.size()) != header.checksum) return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void storeBinary(uint64_t key, GLuint program) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, NULL, &format, binary.data());
+
+    FileHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.key = key;
+    header.format = format;
+    header.length = static_cast<uint32_t>(length);
+    header.checksum = fnv1a(14695981039346656037ULL, binary.data(), binary.size());
+
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory(), error);
+
+    // Écriture dans un fichier temporaire puis renommage : une entrée n'est jamais lue à moitié écrite
+    std::string path = entryPath(key);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(binary.data(), binary.size());
+        if (!out) return;
+    }
+    std::filesystem::rename(temporary, path, error);
+}
+
+}
+
+void ShaderCache::setDirectory(const std::string& path) {
+    directory = path;
+    directoryResolved = true;
+}
+
+GLuint ShaderCache::buildProgram(const char* vertexSource, const char* fragmentSource) {
+    auto start = std::chrono::steady_clock::now();
+    bool useCache = !cacheDirectory().empty() && binariesSupported();
+    GLuint program = 0;
+    uint64_t key = 0;
+
+    if (useCache) {
+        key = programKey(vertexSource, fragmentSource);
+        program = loadBinary(key);
+        if (program) stats.loaded++;
+        else if (std::filesystem::exists(entryPath(key))) stats.rejected++;
+    }
+    if (!program) {
+        program = linkProgram(vertexSource, fragmentSource, useCache);
+        if (program) {
+            stats.compiled++;
+            if (useCache) storeBinary(key, program);
+        }
+    }
+
+    stats.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return program;
+}
+
+const ShaderCache::Stats& ShaderCache::getStats() {
+    return stats;
+}
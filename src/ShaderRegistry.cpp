@@ -0,0 +1,208 @@
+#include "ShaderRegistry.h"
+#include "RenderBackend.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef TETRIS3D_EMBED_SHADERS
+#include "EmbeddedShaders.h"
+#endif
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct Entry {
+    std::string vertexFile;
+    std::string fragmentFile;
+    unsigned int* program;
+};
+
+std::vector<Entry> entries;
+std::string directory;
+bool directoryResolved = false;
+
+// Partagés avec le thread de surveillance
+std::mutex changedMutex;
+std::set<std::string> changedFiles;
+std::atomic<bool> hasChanges{false};
+std::atomic<bool> stopping{false};
+std::thread watcher;
+
+const std::string& shaderDirectory() {
+    if (directoryResolved) return directory;
+    directoryResolved = true;
+    if (const char* path = std::getenv("TETRIS3D_SHADER_DIR")) {
+        directory = path;
+    } else {
+#ifndef TETRIS3D_EMBED_SHADERS
+        directory = TETRIS3D_SHADER_DIR;
+#endif
+    }
+    return directory;
+}
+
+bool readSource(const std::string& name, std::string& source) {
+    if (!shaderDirectory().empty()) {
+        std::ifstream in(shaderDirectory() + "/" + name);
+        if (!in) {
+            std::cout << "Shader introuvable : " << shaderDirectory() << "/" << name << std::endl;
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        source = buffer.str();
+        return true;
+    }
+#ifdef TETRIS3D_EMBED_SHADERS
+    for (const EmbeddedShader& shader : EMBEDDED_SHADERS) {
+        if (name == shader.name) {
+            source = shader.source;
+            return true;
+        }
+    }
+#endif
+    std::cout << "Shader absent de l'exécutable : " << name << std::endl;
+    return false;
+}
+
+unsigned int buildEntry(const Entry& entry) {
+    std::string vertexSource, fragmentSource;
+    if (!readSource(entry.vertexFile, vertexSource) || !readSource(entry.fragmentFile, fragmentSource)) return 0;
+    return RenderBackend::current().createProgram(vertexSource.c_str(), fragmentSource.c_str());
+}
+
+void markChanged(const std::string& name) {
+    std::lock_guard<std::mutex> lock(changedMutex);
+    changedFiles.insert(name);
+    hasChanges.store(true, std::memory_order_release);
+}
+
+#ifdef __linux__
+void watchDirectory(std::string path) {
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    // Les éditeurs qui enregistrent par renommage produisent IN_MOVED_TO
+    if (fd < 0 || inotify_add_watch(fd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        std::cout << "Surveillance des shaders impossible : " << path << std::endl;
+        if (fd >= 0) close(fd);
+        return;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    while (!stopping.load(std::memory_order_acquire)) {
+        // Délai court pour remarquer stopWatching() sans descripteur de réveil
+        pollfd request{fd, POLLIN, 0};
+        if (poll(&request, 1, 200) <= 0) continue;
+
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < length; ) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0) markChanged(event->name);
+            offset += sizeof(inotify_event) + event->len;
+        }
+    }
+    close(fd);
+}
+#else
+// Sans inotify : comparaison périodique des dates de modification
+void watchDirectory(std::string path) {
+    namespace fs = std::filesystem;
+    std::map<std::string, fs::file_time_type> modified;
+    bool first = true;
+
+    while (!stopping.load(std::memory_order_acquire)) {
+        std::error_code error;
+        for (const auto& file : fs::directory_iterator(path, error)) {
+            std::string name = file.path().filename().string();
+            fs::file_time_type time = file.last_write_time(error);
+            auto known = modified.find(name);
+            if (known == modified.end() || known->second != time) {
+                if (!first) markChanged(name);
+                modified[name] = time;
+            }
+        }
+        first = false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    }
+}
+#endif
+
+}
+
+void ShaderRegistry::load(const char* vertexFile, const char* fragmentFile, unsigned int* program) {
+    entries.push_back(Entry{vertexFile, fragmentFile, program});
+    *program = buildEntry(entries.back());
+}
+
+void ShaderRegistry::release(unsigned int* program) {
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].program != program) continue;
+        RenderBackend::current().deleteProgram(*program);
+        *program = 0;
+        entries.erase(entries.begin() + i);
+        return;
+    }
+}
+
+void ShaderRegistry::startWatching() {
+    if (watcher.joinable() || shaderDirectory().empty()) return;
+    stopping.store(false, std::memory_order_release);
+    watcher = std::thread(watchDirectory, shaderDirectory());
+    std::cout << "Rechargement à chaud des shaders : " << shaderDirectory() << std::endl;
+}
+
+void ShaderRegistry::stopWatching() {
+    if (!watcher.joinable()) return;
+    stopping.store(true, std::memory_order_release);
+    watcher.join();
+}
+
+int ShaderRegistry::reloadChanged() {
+    if (!hasChanges.load(std::memory_order_acquire)) return 0;
+
+    std::set<std::string> changed;
+    {
+        std::lock_guard<std::mutex> lock(changedMutex);
+        changed.swap(changedFiles);
+        hasChanges.store(false, std::memory_order_relaxed);
+    }
+
+    int reloaded = 0;
+    for (Entry& entry : entries) {
+        if (!changed.count(entry.vertexFile) && !changed.count(entry.fragmentFile)) continue;
+
+        // En cas d'erreur de compilation, l'ancien programme reste en place
+        unsigned int program = buildEntry(entry);
+        if (!program) {
+            std::cout << "Rechargement ignoré : " << entry.vertexFile << " + " << entry.fragmentFile << std::endl;
+            continue;
+        }
+        RenderBackend::current().deleteProgram(*entry.program);
+        *entry.program = program;
+        reloaded++;
+        std::cout << "Shader rechargé : " << entry.vertexFile << " + " << entry.fragmentFile << std::endl;
+    }
+    return reloaded;
+}
+
+bool ShaderRegistry::isEmbedded() {
+    return shaderDirectory().empty();
+}
+
+const std::string& ShaderRegistry::getDirectory() {
+    return shaderDirectory();
+}
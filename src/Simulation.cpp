@@ -0,0 +1,241 @@
+#include "Simulation.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+Simulation::Simulation(int width, int height, uint64_t seed)
+    : width(width), height(height), storage(width * height, 0), cells(storage.data()),
+      currentPiece(nullptr), queueHead(0), gameState(GameState::WAITING_TO_START),
+      score(0), linesCleared(0), spawnCount(0), rng(static_cast<std::mt19937::result_type>(seed)),
+      pieceDist(0, PIECE_COUNT - 1) {
+    fillQueue();
+}
+
+Simulation::Simulation(const Simulation& other) : currentPiece(nullptr) {
+    copyFrom(other);
+}
+
+Simulation& Simulation::operator=(const Simulation& other) {
+    if (this != &other) copyFrom(other);
+    return *this;
+}
+
+Simulation::~Simulation() {
+    delete currentPiece;
+}
+
+void Simulation::copyFrom(const Simulation& other) {
+    // Une copie possède toujours ses propres cellules, même si l'original
+    // écrit dans un buffer externe
+    width = other.width;
+    height = other.height;
+    storage.assign(other.cells, other.cells + width * height);
+    cells = storage.data();
+
+    delete currentPiece;
+    currentPiece = other.currentPiece ? new Piece(*other.currentPiece) : nullptr;
+
+    std::copy(other.queue, other.queue + QUEUE_SIZE, queue);
+    queueHead = other.queueHead;
+    gameState = other.gameState;
+    score = other.score;
+    linesCleared = other.linesCleared;
+    spawnCount = other.spawnCount;
+    rng = other.rng;
+    pieceDist = other.pieceDist;
+}
+
+void Simulation::bindCells(uint8_t* buffer) {
+    if (buffer == cells) return;
+    std::memcpy(buffer, cells, width * height);
+    cells = buffer;
+}
+
+void Simulation::clearField() {
+    std::memset(cells, 0, width * height);
+}
+
+void Simulation::fillQueue() {
+    queueHead = 0;
+    for (int i = 0; i < QUEUE_SIZE; i++) {
+        queue[i] = static_cast<PieceType>(pieceDist(rng));
+    }
+}
+
+PieceType Simulation::nextQueuedPiece() {
+    PieceType type = queue[queueHead];
+    queue[queueHead] = static_cast<PieceType>(pieceDist(rng));
+    queueHead = (queueHead + 1) % QUEUE_SIZE;
+    return type;
+}
+
+void Simulation::reset() {
+    clearField();
+    delete currentPiece;
+    currentPiece = nullptr;
+    score = 0;
+    linesCleared = 0;
+    spawnCount = 0;
+    gameState = GameState::WAITING_TO_START;
+}
+
+void Simulation::reset(uint64_t seed) {
+    reset();
+    rng.seed(static_cast<std::mt19937::result_type>(seed));
+    pieceDist.reset();
+    fillQueue();
+}
+
+void Simulation::start() {
+    if (gameState != GameState::WAITING_TO_START) return;
+    gameState = GameState::PLAYING;
+    spawnNewPiece();
+}
+
+int Simulation::step(Action action) {
+    PROFILE_ZONE("Simulation::step");
+    if (gameState != GameState::PLAYING) return 0;
+    int scoreBefore = score;
+
+    switch (action) {
+        case Action::LEFT: moveCurrentPiece(-1, 0); break;
+        case Action::RIGHT: moveCurrentPiece(1, 0); break;
+        case Action::ROTATE: rotateCurrentPiece(); break;
+        case Action::SOFT_DROP: update(); break;
+        case Action::HARD_DROP: hardDrop(); break;
+        case Action::NONE: break;
+    }
+
+    // La gravité s'applique à chaque pas, sauf après une chute directe qui
+    // vient de faire apparaître une nouvelle pièce
+    if (action != Action::HARD_DROP) update();
+
+    return score - scoreBefore;
+}
+
+void Simulation::spawnNewPiece() {
+    if (gameState != GameState::PLAYING) return;
+    PieceType type = nextQueuedPiece();
+    currentPiece = new Piece(type, width / 2, height);
+    spawnCount++;
+
+    if (!isValidPosition(currentPiece->getBlockPositions())) {
+        gameState = GameState::GAME_OVER;
+        delete currentPiece;
+        currentPiece = nullptr;
+    }
+}
+
+bool Simulation::isValidPosition(const std::vector<glm::vec2>& positions) const {
+    for (const glm::vec2& pos : positions) {
+        int x = static_cast<int>(pos.x);
+        int y = static_cast<int>(pos.y);
+        if (x < 0 || x >= width || y < 0) return false;
+        if (y < height && cells[y * width + x] != 0) return false;
+    }
+    return true;
+}
+
+void Simulation::moveCurrentPiece(int dx, int dy) {
+    if (!currentPiece || gameState != GameState::PLAYING) return;
+    currentPiece->move(dx, dy);
+    if (!isValidPosition(currentPiece->getBlockPositions())) {
+        currentPiece->move(-dx, -dy);
+    }
+}
+
+void Simulation::rotateCurrentPiece() {
+    if (!currentPiece || gameState != GameState::PLAYING) return;
+
+    currentPiece->rotate();
+
+    if (!isValidPosition(currentPiece->getBlockPositions())) {
+        currentPiece->move(1, 0);
+        if (!isValidPosition(currentPiece->getBlockPositions())) {
+            currentPiece->move(-2, 0);
+            if (!isValidPosition(currentPiece->getBlockPositions())) {
+                currentPiece->move(1, 1);
+                if (!isValidPosition(currentPiece->getBlockPositions())) {
+                    currentPiece->move(0, -1);
+                    currentPiece->rotate();
+                    currentPiece->rotate();
+                    currentPiece->rotate();
+                }
+            }
+        }
+    }
+}
+
+void Simulation::hardDrop() {
+    PROFILE_ZONE("Simulation::hardDrop");
+    if (!currentPiece || gameState != GameState::PLAYING) return;
+    do {
+        currentPiece->move(0, -1);
+    } while (isValidPosition(currentPiece->getBlockPositions()));
+    currentPiece->move(0, 1);
+    lockCurrentPiece();
+}
+
+void Simulation::update() {
+    PROFILE_ZONE("Simulation::update");
+    if (!currentPiece || gameState != GameState::PLAYING) return;
+    currentPiece->move(0, -1);
+    if (!isValidPosition(currentPiece->getBlockPositions())) {
+        currentPiece->move(0, 1);
+        lockCurrentPiece();
+    }
+}
+
+void Simulation::lockCurrentPiece() {
+    PROFILE_ZONE("Simulation::lockCurrentPiece");
+    if (!currentPiece) return;
+
+    std::vector<glm::vec2> positions = currentPiece->getBlockPositions();
+    uint8_t value = static_cast<uint8_t>(currentPiece->getType()) + 1;
+
+    for (const glm::vec2& pos : positions) {
+        int x = static_cast<int>(pos.x);
+        int y = static_cast<int>(pos.y);
+        if (x >= 0 && x < width && y >= 0 && y < height) {
+            cells[y * width + x] = value;
+        }
+    }
+
+    delete currentPiece;
+    currentPiece = nullptr;
+    checkAndClearLines();
+    spawnNewPiece();
+}
+
+void Simulation::checkAndClearLines() {
+    int clearedThisTurn = 0;
+    for (int y = 0; y < height; y++) {
+        if (isLineFull(y)) {
+            clearLine(y);
+            dropLinesAbove(y);
+            clearedThisTurn++;
+            y--;
+        }
+    }
+    if (clearedThisTurn > 0) {
+        linesCleared += clearedThisTurn;
+        score += clearedThisTurn * 100 * (clearedThisTurn > 1 ? 2 : 1);
+    }
+}
+
+bool Simulation::isLineFull(int line) const {
+    for (int x = 0; x < width; x++) {
+        if (cells[line * width + x] == 0) return false;
+    }
+    return true;
+}
+
+void Simulation::clearLine(int line) {
+    std::memset(cells + line * width, 0, width);
+}
+
+void Simulation::dropLinesAbove(int clearedLine) {
+    std::memmove(cells + clearedLine * width, cells + (clearedLine + 1) * width,
+                 (height - clearedLine - 1) * width);
+    std::memset(cells + (height - 1) * width, 0, width);
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "StartupReport.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+struct Phase {
+    const char* name;
+    double milliseconds;
+};
+
+// Initialisé avant main : approximation du lancement du processus
+const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+std::chrono::steady_clock::time_point lastMark = processStart;
+std::vector<Phase> phases;
+bool complete = false;
+
+double since(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}
+
+void StartupReport::mark(const char* phase) {
+    if (complete) return;
+    auto now = std::chrono::steady_clock::now();
+    phases.push_back(Phase{phase, since(lastMark, now)});
+    lastMark = now;
+}
+
+void StartupReport::firstFramePresented() {
+    if (complete) return;
+    mark("première image");
+    complete = true;
+
+    double total = since(processStart, lastMark);
+    std::printf("Démarrage :\n");
+    for (const Phase& phase : phases) {
+        std::printf("  %-28s %8.2f ms\n", phase.name, phase.milliseconds);
+    }
+    std::printf("  %-28s %8.2f ms\n", "temps jusqu'à la 1re image", total);
+    std::fflush(stdout);
+}
+
+bool StartupReport::isComplete() {
+    return complete;
+}
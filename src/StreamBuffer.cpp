@@ -0,0 +1,144 @@
+#include "StreamBuffer.h"
+#include "GlStats.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+StreamBuffer::Totals allTotals;
+
+// Attente d'une fence par tranches, en vidant la file de commandes
+const GLuint64 WAIT_SLICE_NS = 100000000;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+}
+
+const StreamBuffer::Totals& StreamBuffer::totals() {
+    return allTotals;
+}
+
+StreamBuffer::StreamBuffer()
+    : buffer(0), mapped(nullptr), persistent(false), regionSize(0), region(0), used(0), touched(false) {
+    for (int i = 0; i < REGION_COUNT; i++) fences[i] = nullptr;
+}
+
+StreamBuffer::~StreamBuffer() {
+    destroy();
+}
+
+// Tampon créé au premier usage ; TETRIS3D_STREAM=map impose le repli sans mapping persistant
+void StreamBuffer::create(size_t size) {
+    regionSize = size;
+    region = 0;
+    used = 0;
+    const char* mode = std::getenv("TETRIS3D_STREAM");
+    persistent = GLAD_GL_VERSION_4_4 && glBufferStorage && !(mode && std::strcmp(mode, "map") == 0);
+    allTotals.persistent = persistent;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    size_t total = regionSize * REGION_COUNT;
+    if (persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, total, NULL, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, total, flags));
+        if (!mapped) {
+            // Stockage immuable : un nouveau tampon pour le repli
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            persistent = allTotals.persistent = false;
+        }
+    }
+    if (!persistent) glBufferData(GL_ARRAY_BUFFER, total, NULL, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void StreamBuffer::destroy() {
+    for (int i = 0; i < REGION_COUNT; i++) {
+        if (fences[i]) glDeleteSync(fences[i]);
+        fences[i] = nullptr;
+    }
+    if (!buffer) return;
+    if (mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        mapped = nullptr;
+    }
+    // Les draw calls déjà soumises gardent l'ancien stockage en vie côté pilote
+    glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+// Attend que le GPU ait fini de lire la région avant de la réécrire
+void StreamBuffer::waitForRegion(int index) {
+    GLsync fence = fences[index];
+    if (!fence) return;
+    fences[index] = nullptr;
+
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        auto start = std::chrono::steady_clock::now();
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_SLICE_NS);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (allTotals.stalls == 0) {
+            std::cout << "Flux : le GPU a " << REGION_COUNT << " images de retard, attente de "
+                      << ms << " ms (comptée dans GlStats)" << std::endl;
+        }
+        allTotals.stalls++;
+        allTotals.stallMs += ms;
+        GlStats::countStreamStall();
+    }
+    glDeleteSync(fence);
+}
+
+size_t StreamBuffer::write(const void* data, size_t size, size_t alignment) {
+    if (!buffer) create(INITIAL_REGION_SIZE);
+    if (!touched) {
+        waitForRegion(region);
+        touched = true;
+    }
+
+    size_t offset = alignUp(used, alignment);
+    if (offset + size > regionSize) {
+        // Région trop petite pour l'image : anneau recréé deux fois plus grand
+        // (au moins), les écritures déjà faites restent valides dans l'ancien
+        size_t grown = regionSize * 2;
+        while (grown < size + alignment) grown *= 2;
+        destroy();
+        create(grown);
+        allTotals.grows++;
+        offset = 0;
+    }
+
+    size_t position = region * regionSize + offset;
+    if (persistent) {
+        std::memcpy(mapped + position, data, size);
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+        void* target = glMapBufferRange(GL_ARRAY_BUFFER, position, size, flags);
+        if (target) std::memcpy(target, data, size);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    used = offset + size;
+    allTotals.bytes += size;
+    GlStats::countStreamUpload(size);
+    return position;
+}
+
+void StreamBuffer::endFrame() {
+    if (!touched) return;
+    fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    region = (region + 1) % REGION_COUNT;
+    used = 0;
+    touched = false;
+}
@@ -0,0 +1,160 @@
+#include "StressTest.h"
+#include "Board.h"
+#include "GlStats.h"
+#include "RenderBackend.h"
+#include "StreamBuffer.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(p / 100.0 * sorted.size());
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+bool parseSize(const std::string& text, int& width, int& height) {
+    return std::sscanf(text.c_str(), "%dx%d", &width, &height) == 2 && width >= 4 && height >= 4;
+}
+
+}
+
+void StressTest::printUsage() {
+    std::cout << "Usage: Tetris3D [--stress] [--frames N] [--warmup N] [--well LxH]\n"
+              << "                [--pattern empty|half|full|checker|random] [--vsync]" << std::endl;
+}
+
+bool StressTest::parseArguments(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--stress") options.enabled = true;
+        else if (arg == "--frames" && hasValue) options.frames = std::atoi(argv[++i]);
+        else if (arg == "--warmup" && hasValue) options.warmupFrames = std::atoi(argv[++i]);
+        else if (arg == "--well" && hasValue) {
+            if (!parseSize(argv[++i], options.width, options.height)) return false;
+        }
+        else if (arg == "--pattern" && hasValue) options.pattern = argv[++i];
+        else if (arg == "--vsync") options.vsync = true;
+        else return false;
+    }
+    return options.frames > 0 && options.warmupFrames >= 0;
+}
+
+bool StressTest::fillPattern(Board& board, const std::string& pattern) {
+    Simulation& simulation = board.getSimulation();
+    int width = simulation.getWidth();
+    int height = simulation.getHeight();
+    std::mt19937 rng(1);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            bool filled;
+            if (pattern == "empty") filled = false;
+            else if (pattern == "half") filled = y < height / 2 && (x + y) % width != 0;
+            else if (pattern == "full") filled = true;
+            else if (pattern == "checker") filled = (x + y) % 2 == 0;
+            else if (pattern == "random") filled = rng() % 100 < 60;
+            else return false;
+            uint8_t type = static_cast<uint8_t>((x * 7 + y * 3) % Simulation::PIECE_COUNT) + 1;
+            simulation.setCell(x, y, filled ? type : 0);
+        }
+    }
+    return true;
+}
+
+int StressTest::run(GLFWwindow* window, Board& board, const Options& options) {
+    if (!fillPattern(board, options.pattern)) {
+        std::cout << "Motif inconnu : " << options.pattern << std::endl;
+        printUsage();
+        return 1;
+    }
+    // Sans fenêtre (headless), glFinish remplace la présentation
+    if (window) glfwSwapInterval(options.vsync ? 1 : 0);
+    GlStats::enable("");
+
+    std::vector<double> frameMs;
+    std::vector<double> cpuMs;
+    frameMs.reserve(options.frames);
+    cpuMs.reserve(options.frames);
+    unsigned long long draws = 0;
+    StreamBuffer::Totals streamStart;
+    unsigned long long patchedStart = 0;
+
+    int total = options.warmupFrames + options.frames;
+    auto frameStart = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < total && !(window && glfwWindowShouldClose(window)); frame++) {
+        if (frame == options.warmupFrames) {
+            streamStart = StreamBuffer::totals();
+            patchedStart = board.getSceneCubes().getPatchedInstances();
+        }
+        glClearColor(0.96f, 0.91f, 0.94f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        board.render();
+        auto submitted = std::chrono::steady_clock::now();
+        RenderBackend::current().endFrame();
+        GlStats::endFrame();
+
+        if (window) {
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        } else {
+            glFinish();
+        }
+        auto frameEnd = std::chrono::steady_clock::now();
+
+        // Les premières images créent les cubes et chauffent le pilote
+        if (frame >= options.warmupFrames) {
+            frameMs.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+            cpuMs.push_back(std::chrono::duration<double, std::milli>(submitted - frameStart).count());
+            draws += GlStats::lastFrame().drawCalls;
+        }
+        frameStart = frameEnd;
+    }
+    GlStats::disable();
+
+    if (frameMs.empty()) {
+        std::cout << "Aucune image mesurée" << std::endl;
+        return 1;
+    }
+
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    double frameSum = 0.0;
+    for (double ms : frameMs) frameSum += ms;
+    double cpuSum = 0.0;
+    for (double ms : cpuMs) cpuSum += ms;
+    size_t count = frameMs.size();
+
+    std::printf("Tetris3D stress : %s, %s\n", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+    std::printf("puits %dx%d, motif %s, vsync %s, %zu images (+%d de chauffe)\n",
+                board.getFieldWidth(), board.getFieldHeight(), options.pattern.c_str(),
+                options.vsync ? "on" : "off", count, options.warmupFrames);
+    std::printf("temps d'image (ms) : moy %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f\n",
+                frameSum / count, percentile(sorted, 50), percentile(sorted, 95),
+                percentile(sorted, 99), sorted.back());
+    std::printf("images/s moy %.1f, CPU %.3f ms/image, %.1f draw calls/image\n",
+                1000.0 * count / frameSum, cpuSum / count, static_cast<double>(draws) / count);
+    const StreamBuffer::Totals& stream = StreamBuffer::totals();
+    std::printf("anneau de flux (%s) : %.1f Ko/image, %llu attentes du GPU (%.3f ms), %u agrandissements\n",
+                stream.persistent ? "mapping persistant" : "glMapBufferRange",
+                (stream.bytes - streamStart.bytes) / 1024.0 / count, stream.stalls - streamStart.stalls,
+                stream.stallMs - streamStart.stallMs, stream.grows - streamStart.grows);
+    const ResidentCubes& cubes = board.getSceneCubes();
+    std::printf("scène résidente (%s) : %.1f instances renvoyées/image\n",
+                cubes.isIndirect() ? "multi-draw indirect" : "draws instanciées par plage",
+                static_cast<double>(cubes.getPatchedInstances() - patchedStart) / count);
+    if (const DynamicResolution* resolution = board.getDynamicResolution()) {
+        std::printf("résolution dynamique : échelle finale %.2f (%dx%d), scène GPU %.3f ms\n",
+                    resolution->getScale(), resolution->getSceneWidth(), resolution->getSceneHeight(),
+                    resolution->getSceneMs());
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "TetrisEnv.h"
+#include "Profiler.h"
+#include "Simulation.h"
+#include <vector>
+
+static_assert(TETRIS_ENV_QUEUE_SIZE == Simulation::QUEUE_SIZE, "taille de la file incohérente");
+
+struct TetrisEnv {
+    int width;
+    int height;
+    std::vector<Simulation> simulations;
+
+    uint8_t* cells = nullptr;
+    int32_t* pieces = nullptr;
+    int8_t* queues = nullptr;
+    float* rewards = nullptr;
+    uint8_t* dones = nullptr;
+
+    bool isBound() const { return cells && pieces && queues && rewards && dones; }
+};
+
+// Écrit tout ce qui n'est pas déjà partagé avec la simulation (les cellules
+// le sont via bindCells)
+static void writeObservation(TetrisEnv* env, int index, int reward) {
+    const Simulation& sim = env->simulations[index];
+
+    int32_t* piece = env->pieces + index * TETRIS_ENV_PIECE_FIELDS;
+    const Piece* current = sim.getCurrentPiece();
+    if (current) {
+        piece[0] = static_cast<int32_t>(current->getType());
+        piece[1] = static_cast<int32_t>(current->getX());
+        piece[2] = static_cast<int32_t>(current->getY());
+        piece[3] = current->getRotation();
+    } else {
+        piece[0] = -1;
+        piece[1] = piece[2] = piece[3] = 0;
+    }
+
+    int8_t* queue = env->queues + index * TETRIS_ENV_QUEUE_SIZE;
+    for (int i = 0; i < TETRIS_ENV_QUEUE_SIZE; i++) {
+        queue[i] = static_cast<int8_t>(sim.getQueuedPiece(i));
+    }
+
+    env->rewards[index] = static_cast<float>(reward);
+    env->dones[index] = sim.getGameState() == GameState::GAME_OVER ? 1 : 0;
+}
+
+extern "C" {
+
+TetrisEnv* tetris_env_create(int num_envs, int width, int height) {
+    if (num_envs <= 0 || width < 0 || height < 0) return nullptr;
+    if (width == 0) width = Simulation::DEFAULT_WIDTH;
+    if (height == 0) height = Simulation::DEFAULT_HEIGHT;
+    // Les pièces apparaissent au centre et peuvent s'étendre de 2 cases à gauche
+    if (width < 4 || height < 4) return nullptr;
+
+    TetrisEnv* env = new TetrisEnv();
+    env->width = width;
+    env->height = height;
+    env->simulations.reserve(num_envs);
+    for (int i = 0; i < num_envs; i++) {
+        env->simulations.emplace_back(width, height, i);
+    }
+    return env;
+}
+
+void tetris_env_destroy(TetrisEnv* env) {
+    delete env;
+}
+
+int tetris_env_num_envs(const TetrisEnv* env) {
+    return env ? static_cast<int>(env->simulations.size()) : -1;
+}
+
+int tetris_env_width(const TetrisEnv* env) {
+    return env ? env->width : -1;
+}
+
+int tetris_env_height(const TetrisEnv* env) {
+    return env ? env->height : -1;
+}
+
+int tetris_env_bind_buffers(TetrisEnv* env, uint8_t* cells, int32_t* pieces,
+                            int8_t* queues, float* rewards, uint8_t* dones) {
+    if (!env || !cells || !pieces || !queues || !rewards || !dones) return -1;
+
+    env->cells = cells;
+    env->pieces = pieces;
+    env->queues = queues;
+    env->rewards = rewards;
+    env->dones = dones;
+
+    int cellCount = env->width * env->height;
+    for (size_t i = 0; i < env->simulations.size(); i++) {
+        env->simulations[i].bindCells(cells + i * cellCount);
+        writeObservation(env, static_cast<int>(i), 0);
+    }
+    return 0;
+}
+
+int tetris_env_reset_one(TetrisEnv* env, int index, uint64_t seed) {
+    if (!env || !env->isBound()) return -1;
+    if (index < 0 || index >= static_cast<int>(env->simulations.size())) return -1;
+
+    Simulation& sim = env->simulations[index];
+    sim.reset(seed);
+    sim.start();
+    writeObservation(env, index, 0);
+    return 0;
+}
+
+int tetris_env_reset(TetrisEnv* env, const uint64_t* seeds) {
+    if (!env || !env->isBound() || !seeds) return -1;
+    for (size_t i = 0; i < env->simulations.size(); i++) {
+        tetris_env_reset_one(env, static_cast<int>(i), seeds[i]);
+    }
+    return 0;
+}
+
+int tetris_env_step(TetrisEnv* env, const int32_t* actions) {
+    if (!env || !env->isBound() || !actions) return -1;
+    PROFILE_ZONE("tetris_env_step");
+
+    for (size_t i = 0; i < env->simulations.size(); i++) {
+        int32_t action = actions[i];
+        if (action < TETRIS_ACTION_NONE || action > TETRIS_ACTION_HARD_DROP) {
+            action = TETRIS_ACTION_NONE;
+        }
+        int reward = env->simulations[i].step(static_cast<Action>(action));
+        writeObservation(env, static_cast<int>(i), reward);
+    }
+    return 0;
+}
+
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "TextRenderer.h"
+#include "RenderBackend.h"
+#include "ShaderRegistry.h"
 #include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <vector>
 
 // Police bitmap 5x7 pour afficher du texte 
@@ -98,85 +100,47 @@ static const unsigned char FONT_DATA[][7] = {
     {0x00,0x00,0x1F,0x02,0x04,0x08,0x1F},
 };
 
-TextRenderer::TextRenderer() {
+TextRenderer::TextRenderer() : queuedBatches(0) {
     initShaders();
     initBuffers();
     projection = glm::ortho(0.0f, 1200.0f, 0.0f, 900.0f);
 }
 
 TextRenderer::~TextRenderer() {
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteProgram(shaderProgram);
+    RenderBackend& backend = RenderBackend::current();
+    backend.deleteVertexArray(VAO);
+    backend.releaseStream();
+    ShaderRegistry::release(&shaderProgram);
 }
 
 void TextRenderer::initShaders() {
-    const char* vertexSource = R"(
-        #version 330 core
-        layout (location = 0) in vec2 aPos;
-        uniform mat4 projection;
-        void main() {
-            gl_Position = projection * vec4(aPos, 0.0, 1.0);
-        }
-    )";
-    
-    const char* fragmentSource = R"(
-        #version 330 core
-        out vec4 FragColor;
-        uniform vec3 textColor;
-        void main() {
-            FragColor = vec4(textColor, 1.0);
-        }
-    )";
-    
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexSource, NULL);
-    glCompileShader(vertexShader);
-    
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
-    glCompileShader(fragmentShader);
-    
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    ShaderRegistry::load("text_vertex_shader.glsl", "text_fragment_shader.glsl", &shaderProgram);
 }
 
+// Les sommets vivent dans l'anneau de flux : l'attribut est pointé à chaque lot
 void TextRenderer::initBuffers() {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 2 * 100, NULL, GL_DYNAMIC_DRAW);
-    
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0);
-    glEnableVertexAttribArray(0);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    RenderBackend& backend = RenderBackend::current();
+    VAO = backend.createVertexArray();
+    backend.acquireStream();
 }
 
 void TextRenderer::setProjection(int screenWidth, int screenHeight) {
     projection = glm::ortho(0.0f, (float)screenWidth, 0.0f, (float)screenHeight);
 }
 
-void TextRenderer::renderText(const std::string& text, float x, float y, float scale, glm::vec3 color) {
-    glUseProgram(shaderProgram);
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    glUniform3fv(glGetUniformLocation(shaderProgram, "textColor"), 1, glm::value_ptr(color));
-    
-    glBindVertexArray(VAO);
-    
+void TextRenderer::fitLayout(int screenWidth, int screenHeight, float layoutWidth, float layoutHeight) {
+    float scale = std::min(screenWidth / layoutWidth, screenHeight / layoutHeight);
+    float marginX = (screenWidth / scale - layoutWidth) * 0.5f;
+    float marginY = (screenHeight / scale - layoutHeight) * 0.5f;
+    projection = glm::ortho(-marginX, layoutWidth + marginX, -marginY, layoutHeight + marginY);
+}
+
+void TextRenderer::appendText(std::vector<glm::vec4>& rects, const std::string& text,
+                              float x, float y, float scale) {
     float pixelSize = scale;
     float charWidth = 6 * pixelSize;
-    float charHeight = 8 * pixelSize;
     
-    // On dessine chaque lettre une par une
+    // Un petit carré pour chaque pixel allumé de chaque lettre
     for (size_t i = 0; i < text.length(); i++) {
         char c = text[i];
         if (c < 32 || c > 122) c = 32;
@@ -184,33 +148,68 @@ void TextRenderer::renderText(const std::string& text, float x, float y, float s
         int charIndex = c - 32;
         if (charIndex < 0 || charIndex >= 91) charIndex = 0;
         
-        std::vector<float> vertices;
-        
-        // On construit des petits carrés pour chaque pixel de la lettre
         for (int row = 0; row < 7; row++) {
             unsigned char rowData = FONT_DATA[charIndex][row];
             for (int col = 0; col < 5; col++) {
                 if (rowData & (1 << (4 - col))) {
                     float px = x + i * charWidth + col * pixelSize;
                     float py = y + (6 - row) * pixelSize;
-                    
-                    vertices.push_back(px); vertices.push_back(py);
-                    vertices.push_back(px + pixelSize); vertices.push_back(py);
-                    vertices.push_back(px + pixelSize); vertices.push_back(py + pixelSize);
-                    
-                    vertices.push_back(px); vertices.push_back(py);
-                    vertices.push_back(px + pixelSize); vertices.push_back(py + pixelSize);
-                    vertices.push_back(px); vertices.push_back(py + pixelSize);
+                    rects.push_back(glm::vec4(px, py, pixelSize, pixelSize));
                 }
             }
         }
-        
-        if (!vertices.empty()) {
-            glBindBuffer(GL_ARRAY_BUFFER, VBO);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(float), vertices.data());
-            glDrawArrays(GL_TRIANGLES, 0, vertices.size() / 2);
-        }
     }
+}
+
+void TextRenderer::renderText(const std::string& text, float x, float y, float scale, glm::vec3 color) {
+    // Toute la chaîne en une seule draw call
+    rectScratch.clear();
+    appendText(rectScratch, text, x, y, scale);
+    renderRects(rectScratch, color);
+}
+
+void TextRenderer::queueText(const std::string& text, float x, float y, float scale, glm::vec3 color) {
+    size_t index = 0;
+    while (index < queuedBatches && batches[index].color != color) index++;
+    if (index == queuedBatches) {
+        if (queuedBatches == batches.size()) batches.push_back(Batch());
+        batches[index].color = color;
+        batches[index].rects.clear();
+        queuedBatches++;
+    }
+    appendText(batches[index].rects, text, x, y, scale);
+}
+
+// Les lots partent dans l'ordre où leur couleur est apparue
+void TextRenderer::flush() {
+    for (size_t i = 0; i < queuedBatches; i++) renderRects(batches[i].rects, batches[i].color);
+    queuedBatches = 0;
+}
+
+void TextRenderer::renderRect(float x, float y, float width, float height, glm::vec3 color) {
+    renderRects(std::vector<glm::vec4>(1, glm::vec4(x, y, width, height)), color);
+}
+
+void TextRenderer::renderRects(const std::vector<glm::vec4>& rects, glm::vec3 color) {
+    if (rects.empty()) return;
     
-    glBindVertexArray(0);
-}
\ No newline at end of file
+    RenderBackend& backend = RenderBackend::current();
+    backend.useProgram(shaderProgram);
+    backend.setUniform(shaderProgram, "projection", projection);
+    backend.setUniform(shaderProgram, "textColor", color);
+    
+    vertices.clear();
+    for (const glm::vec4& r : rects) {
+        float x0 = r.x, y0 = r.y, x1 = r.x + r.z, y1 = r.y + r.w;
+        float quad[12] = {x0, y0, x1, y0, x1, y1, x0, y0, x1, y1, x0, y1};
+        vertices.insert(vertices.end(), quad, quad + 12);
+    }
+    // Chaque lot à la suite du précédent dans l'anneau : jamais réécrit avant que le GPU l'ait lu
+    size_t offset = backend.streamData(vertices.data(), vertices.size() * sizeof(float), sizeof(float));
+    backend.bindVertexArray(VAO);
+    backend.bindBuffer(RenderBackend::BufferTarget::VERTICES, backend.streamBuffer());
+    backend.vertexAttribute(0, 2, 2 * sizeof(float), offset);
+    backend.drawArrays(RenderBackend::Primitive::TRIANGLES, 0, static_cast<int>(vertices.size() / 2));
+    
+    backend.bindVertexArray(0);
+}
@@ -0,0 +1,157 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Données d'une entrée : score (32 bits), profondeur (8), génération (8), occupée (1)
+const uint64_t USED_BIT = 1ULL << 48;
+
+uint64_t packData(float score, int depth, uint8_t generation) {
+    uint32_t scoreBits;
+    std::memcpy(&scoreBits, &score, sizeof(scoreBits));
+    return scoreBits | (static_cast<uint64_t>(depth & 0xFF) << 32) |
+           (static_cast<uint64_t>(generation) << 40) | USED_BIT;
+}
+
+float unpackScore(uint64_t data) {
+    uint32_t scoreBits = static_cast<uint32_t>(data);
+    float score;
+    std::memcpy(&score, &scoreBits, sizeof(score));
+    return score;
+}
+
+int unpackDepth(uint64_t data) { return static_cast<int>((data >> 32) & 0xFF); }
+uint8_t unpackGeneration(uint64_t data) { return static_cast<uint8_t>(data >> 40); }
+
+uint64_t mix(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
+
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+    : generation(0), probes(0), hits(0), stores(0), used(0) {
+    // Nombre de buckets arrondi à la puissance de deux inférieure
+    size_t wanted = (megabytes * 1024 * 1024) / sizeof(Bucket);
+    bucketCount = 1;
+    while (bucketCount * 2 <= wanted) bucketCount *= 2;
+
+    buckets.reset(new Bucket[bucketCount]);
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (size_t b = 0; b < bucketCount; b++) {
+        for (Entry& entry : buckets[b].entries) {
+            entry.keyXorData.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    used.store(0, std::memory_order_relaxed);
+}
+
+bool TranspositionTable::probe(uint64_t key, int depth, float& score) {
+    probes.fetch_add(1, std::memory_order_relaxed);
+
+    Bucket& bucket = bucketFor(key);
+    for (Entry& entry : bucket.entries) {
+        uint64_t data = entry.data.load(std::memory_order_relaxed);
+        uint64_t keyXorData = entry.keyXorData.load(std::memory_order_relaxed);
+        if ((keyXorData ^ data) != key || !(data & USED_BIT)) continue;
+        if (unpackDepth(data) != depth) continue;
+
+        score = unpackScore(data);
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, float score) {
+    stores.fetch_add(1, std::memory_order_relaxed);
+
+    uint8_t currentGeneration = generation.load(std::memory_order_relaxed);
+    uint64_t newData = packData(score, depth, currentGeneration);
+    Bucket& bucket = bucketFor(key);
+
+    // Remplacement : même clé, sinon entrée vide, sinon la plus ancienne
+    // génération puis la plus faible profondeur
+    int victim = 0;
+    int victimPriority = -1;
+    bool filling = false;
+    for (int i = 0; i < BUCKET_SIZE; i++) {
+        uint64_t data = bucket.entries[i].data.load(std::memory_order_relaxed);
+        uint64_t keyXorData = bucket.entries[i].keyXorData.load(std::memory_order_relaxed);
+        if (!(data & USED_BIT) || (keyXorData ^ data) == key) {
+            victim = i;
+            filling = !(data & USED_BIT);
+            break;
+        }
+        uint8_t age = static_cast<uint8_t>(currentGeneration - unpackGeneration(data));
+        int priority = age * 256 + (255 - unpackDepth(data));
+        if (priority > victimPriority) {
+            victim = i;
+            victimPriority = priority;
+        }
+    }
+
+    bucket.entries[victim].keyXorData.store(key ^ newData, std::memory_order_relaxed);
+    bucket.entries[victim].data.store(newData, std::memory_order_relaxed);
+    if (filling) used.fetch_add(1, std::memory_order_relaxed);
+}
+
+TranspositionTable::Stats TranspositionTable::getStats() const {
+    Stats stats;
+    stats.probes = probes.load(std::memory_order_relaxed);
+    stats.hits = hits.load(std::memory_order_relaxed);
+    stats.stores = stores.load(std::memory_order_relaxed);
+    stats.capacity = bucketCount * BUCKET_SIZE;
+    // Deux threads remplissant la même entrée vide la comptent deux fois
+    stats.used = std::min(used.load(std::memory_order_relaxed), stats.capacity);
+    return stats;
+}
+
+void TranspositionTable::resetStats() {
+    probes.store(0, std::memory_order_relaxed);
+    hits.store(0, std::memory_order_relaxed);
+    stores.store(0, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::hashPosition(const uint8_t* cells, int width, int height,
+                                          const PieceType* pieces, int pieceCount) {
+    uint64_t h = mix(0x9E3779B97F4A7C15ULL ^ (static_cast<uint64_t>(width) << 32) ^ height);
+
+    // Occupation seule (pas la couleur), par mots de 64 cellules
+    uint64_t bits = 0;
+    int bitCount = 0;
+    int cellCount = width * height;
+    for (int i = 0; i < cellCount; i++) {
+        bits |= static_cast<uint64_t>(cells[i] != 0) << bitCount;
+        if (++bitCount == 64) {
+            h = mix(h ^ bits);
+            bits = 0;
+            bitCount = 0;
+        }
+    }
+    if (bitCount > 0) h = mix(h ^ bits);
+
+    for (int i = 0; i < pieceCount; i++) {
+        h = mix(h ^ (static_cast<uint64_t>(pieces[i]) + 1) * 0xD6E8FEB86659FD93ULL);
+    }
+    return h;
+}
+uint64_t TranspositionTable::hashParameters(const float* values, int count, uint64_t seed) {
+    uint64_t h = mix(0xA0761D6478BD642FULL ^ seed);
+    for (int i = 0; i < count; i++) {
+        uint32_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        h = mix(h ^ bits);
+    }
+    return h;
+}
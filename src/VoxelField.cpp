@@ -0,0 +1,104 @@
+#include "VoxelField.h"
+#include "Cube.h"
+#include "Piece.h"
+#include "RenderBackend.h"
+#include "ShaderRegistry.h"
+#include "Simulation.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+bool VoxelField::parseArguments(int& argc, char** argv, Options& options) {
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--voxel") options.enabled = true;
+        else argv[kept++] = argv[i];
+    }
+    argc = kept;
+    return true;
+}
+
+void VoxelField::printUsage() {
+    std::cout << "       Tetris3D [--voxel]   (pile rendue par lancer de rayons)" << std::endl;
+}
+
+VoxelField::VoxelField(int width, int height)
+    : width(width), height(height), uploaded(static_cast<size_t>(width) * height, 0), uploadedRows(0) {
+    // Le cube unité partagé sert de géométrie englobante
+    Cube::acquireShared();
+    ShaderRegistry::load("voxel_vertex_shader.glsl", "voxel_fragment_shader.glsl", &shaderProgram);
+
+    RenderBackend& backend = RenderBackend::current();
+    texture = backend.createTexture();
+    backend.bindTexture(0, texture);
+    backend.textureImage(width, height, uploaded.data());
+    backend.bindTexture(0, 0);
+
+    model = glm::translate(glm::mat4(1.0f), glm::vec3((width - 1) * 0.5f, (height - 1) * 0.5f, 0.0f));
+    model = glm::scale(model, glm::vec3(width, height, 1.0f));
+}
+
+VoxelField::~VoxelField() {
+    RenderBackend::current().deleteTexture(texture);
+    ShaderRegistry::release(&shaderProgram);
+    Cube::releaseShared();
+}
+
+void VoxelField::update(const uint8_t* cells) {
+    RenderBackend& backend = RenderBackend::current();
+    bool bound = false;
+    // Lignes modifiées regroupées en plages contiguës : un glTexSubImage par plage
+    for (int y = 0; y < height; ) {
+        size_t offset = static_cast<size_t>(y) * width;
+        if (std::memcmp(cells + offset, uploaded.data() + offset, width) == 0) {
+            y++;
+            continue;
+        }
+        int first = y;
+        while (y < height && std::memcmp(cells + static_cast<size_t>(y) * width,
+                                         uploaded.data() + static_cast<size_t>(y) * width, width) != 0) {
+            y++;
+        }
+        size_t begin = static_cast<size_t>(first) * width;
+        size_t end = static_cast<size_t>(y) * width;
+        std::memcpy(uploaded.data() + begin, cells + begin, end - begin);
+
+        if (!bound) {
+            backend.bindTexture(0, texture);
+            bound = true;
+        }
+        backend.textureSubImage(first, width, y - first, uploaded.data() + begin);
+        uploadedRows += y - first;
+    }
+}
+
+void VoxelField::render(const glm::mat4& view, const glm::mat4& projection, int viewportHeight) {
+    RenderBackend& backend = RenderBackend::current();
+    backend.useProgram(shaderProgram);
+    backend.setUniform(shaderProgram, "model", model);
+    backend.setUniform(shaderProgram, "view", view);
+    backend.setUniform(shaderProgram, "projection", projection);
+
+    // Taille d'un pixel à distance 1 : projection[1][1] = 1 / tan(fov / 2)
+    float pixelScale = 2.0f / (projection[1][1] * viewportHeight);
+    backend.setUniform(shaderProgram, "grid", glm::vec3(width, height, pixelScale));
+    backend.setUniform(shaderProgram, "eyePos", glm::vec3(glm::inverse(view)[3]));
+    backend.setUniform(shaderProgram, "lightPos", Cube::LIGHT_POSITION);
+    backend.setUniform(shaderProgram, "lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+    backend.setUniform(shaderProgram, "viewPos", Cube::VIEW_POSITION);
+
+    static const char* paletteNames[Simulation::PIECE_COUNT] = {
+        "palette[0]", "palette[1]", "palette[2]", "palette[3]", "palette[4]", "palette[5]"
+    };
+    for (int i = 0; i < Simulation::PIECE_COUNT; i++) {
+        backend.setUniform(shaderProgram, paletteNames[i], Piece::colorFor(static_cast<PieceType>(i)));
+    }
+    backend.setUniform(shaderProgram, "cells", 0);
+    backend.bindTexture(0, texture);
+
+    backend.bindVertexArray(Cube::VAO);
+    backend.drawElements(RenderBackend::Primitive::TRIANGLES, Cube::INDEX_COUNT);
+    backend.bindVertexArray(0);
+    backend.bindTexture(0, 0);
+}
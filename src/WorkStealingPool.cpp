@@ -0,0 +1,91 @@
+#include "WorkStealingPool.h"
+#include "Profiler.h"
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+    : pending(0), nextQueue(0), steals(0), queued(0), stopping(false) {
+    if (threadCount == 0) threadCount = 1;
+
+    for (unsigned i = 0; i < threadCount; i++) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void WorkStealingPool::submit(Task task) {
+    pending++;
+
+    // Répartition circulaire ; le vol rééquilibre ensuite les parties longues
+    unsigned index = nextQueue++ % queues.size();
+    // Compté avant d'être publiée : un worker qui la prend aussitôt ne peut
+    // pas faire passer queued sous zéro
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        queued++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return pending.load() == 0; });
+}
+
+bool WorkStealingPool::popLocal(unsigned index, Task& task) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned index, Task& task) {
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        WorkerQueue& victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        steals++;
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(unsigned index) {
+    PROFILE_THREAD_NAME("pool worker");
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            queued--;
+            {
+                PROFILE_ZONE("WorkStealingPool::task");
+                task();
+            }
+            if (--pending == 0) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex);
+        workAvailable.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
\ No newline at end of file
@@ -1,7 +1,23 @@
 #include "Board.h"
+#include "DynamicResolution.h"
+#include "FrameCapture.h"
+#include "FramePacer.h"
+#include "GlStats.h"
+#include "HeadlessContext.h"
+#include "Mosaic.h"
+#include "Ponderer.h"
+#include "Profiler.h"
+#include "RenderBackend.h"
+#include "RenderScheduler.h"
+#include "ShaderCache.h"
+#include "ShaderRegistry.h"
+#include "StartupReport.h"
+#include "StressTest.h"
+#include "VoxelField.h"
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 #include <string>
 
@@ -13,9 +29,23 @@ const unsigned int SCR_HEIGHT = 900;
 
 Board* board = nullptr;
 GLFWwindow* window = nullptr;
+RenderScheduler* scheduler = nullptr;
+FramePacer* framePacer = nullptr;
+FrameCapture* capture = nullptr;
+Mosaic* activeMosaic = nullptr;
+
+bool showHint = false;
+bool autoplay = false;
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
+    if (board) board->setViewportSize(width, height);
+    if (activeMosaic) activeMosaic->resize(width, height);
+    if (scheduler) scheduler->requestRedraw();
+}
+
+void window_refresh_callback(GLFWwindow* window) {
+    if (scheduler) scheduler->requestRedraw();
 }
 
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
@@ -36,6 +66,43 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
                 case GLFW_KEY_UP: case GLFW_KEY_W:  
                     if (state == GameState::PLAYING) board->rotateCurrentPiece();
                     break;
+                case GLFW_KEY_H:
+                    if (action == GLFW_PRESS) showHint = !showHint;
+                    break;
+                case GLFW_KEY_P:
+                    if (action == GLFW_PRESS) {
+                        autoplay = !autoplay;
+                        board->setAutoplay(autoplay);
+                    }
+                    break;
+                case GLFW_KEY_F3:
+                    if (action == GLFW_PRESS) board->setPerfOverlay(!board->isPerfOverlayVisible());
+                    break;
+                case GLFW_KEY_V:
+                    if (action == GLFW_PRESS) board->setVoxelField(!board->isVoxelField());
+                    break;
+                case GLFW_KEY_F4:
+                    if (action == GLFW_PRESS) {
+                        if (GlStats::isEnabled()) GlStats::disable();
+                        else GlStats::enable("tetris3d_glstats.csv");
+                    }
+                    break;
+                case GLFW_KEY_F10:
+                    if (action == GLFW_PRESS && capture) {
+                        if (capture->isRecording()) {
+                            capture->stop();
+                        } else {
+                            int width, height;
+                            glfwGetFramebufferSize(window, &width, &height);
+                            double periodMs = framePacer ? framePacer->getPeriodMs() : 0.0;
+                            int fps = periodMs > 0.0 ? static_cast<int>(1000.0 / periodMs + 0.5) : 60;
+                            capture->start("tetris3d_capture.y4m", width, height, fps);
+                        }
+                    }
+                    break;
+                case GLFW_KEY_F9:
+                    if (action == GLFW_PRESS) Profiler::dumpChromeTrace("tetris3d_trace.json");
+                    break;
                 case GLFW_KEY_ESCAPE:
                     glfwSetWindowShouldClose(window, true);
                     break;
@@ -44,6 +111,24 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
     }
 }
 
+// Rapproche la pièce du placement visé d'une action à la fois : rotation,
+// puis déplacement horizontal. Retourne true quand il ne reste qu'à la faire tomber.
+bool stepAutoplay(const Autoplayer::Placement& target, int& stepsTaken) {
+    const Piece* piece = board->getSimulation().getCurrentPiece();
+    if (!piece || !target.valid) return true;
+    
+    // Placement inatteignable (pièce bloquée) : on abandonne et on la lâche
+    if (stepsTaken > 16) return true;
+    stepsTaken++;
+    
+    int x = static_cast<int>(piece->getX());
+    if (piece->getRotation() != target.rotation) board->rotateCurrentPiece();
+    else if (x < target.x) board->moveCurrentPiece(1, 0);
+    else if (x > target.x) board->moveCurrentPiece(-1, 0);
+    else return true;
+    return false;
+}
+
 void setWindowIcon(GLFWwindow* window, const char* iconPath) {
     int width, height, channels;
     
@@ -64,8 +149,164 @@ void setWindowIcon(GLFWwindow* window, const char* iconPath) {
     }
 }
 
-int main() {
+// Partie jouée par l'Autoplayer et enregistrée image par image, cadencée
+// comme à 60 images/s : une action toutes les 3 images, gravité toutes les 24
+int recordDemo(const std::string& path, int frames) {
+    FrameCapture recorder;
+    if (!recorder.start(path, SCR_WIDTH, SCR_HEIGHT, 60)) return 1;
+
+    Autoplayer player;
+    Autoplayer::Placement target;
+    unsigned spawn = 0;
+    int steps = 0;
+    bool dropping = false;
+    board->startGame();
+
+    for (int frame = 0; frame < frames && board->getGameState() == GameState::PLAYING; frame++) {
+        const Simulation& simulation = board->getSimulation();
+        if (simulation.getSpawnCount() != spawn) {
+            spawn = simulation.getSpawnCount();
+            target = player.findBestPlacement(simulation);
+            steps = 0;
+            dropping = false;
+        }
+        if (frame % 3 == 0 && !dropping) dropping = stepAutoplay(target, steps);
+        if (frame % (dropping ? 3 : 24) == 0) board->update();
+
+        glClearColor(0.96f, 0.91f, 0.94f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        board->render();
+        RenderBackend::current().endFrame();
+        recorder.captureFrame();
+    }
+    recorder.stop();
+    return 0;
+}
+
+// Mosaïque sans fenêtre : --frames ticks de jeu puis une image (--screenshot)
+int renderHeadlessMosaic(const HeadlessContext& context, const Mosaic::Options& mosaicOptions,
+                         const HeadlessContext::Options& headless, const StressTest::Options& stress) {
+    Mosaic mosaic(mosaicOptions.boards, SCR_WIDTH, SCR_HEIGHT, stress.width, stress.height);
+    mosaic.advance(stress.frames);
+    glClearColor(0.96f, 0.91f, 0.94f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    mosaic.render();
+    RenderBackend::current().endFrame();
+    std::cout << "Mosaïque : " << mosaic.getBoardCount() << " parties, " << mosaic.getInstanceCount()
+              << " cubes, " << mosaic.getGamesPlayed() << " parties terminées" << std::endl;
+    if (!headless.screenshot.empty() && !context.writeScreenshot(headless.screenshot)) return 1;
+    return 0;
+}
+
+// Rendu sans fenêtre dans un FBO : benchmark --stress, vidéo --record, --screenshot
+int runHeadless(const HeadlessContext::Options& headless, const StressTest::Options& stress,
+                const Mosaic::Options& mosaicOptions, const VoxelField::Options& voxel,
+                const DynamicResolution::Options& resolution) {
+    HeadlessContext context;
+    if (!context.create(SCR_WIDTH, SCR_HEIGHT)) return 1;
+    glEnable(GL_DEPTH_TEST);
+    if (mosaicOptions.boards > 0) return renderHeadlessMosaic(context, mosaicOptions, headless, stress);
+
+    board = new Board(stress.width, stress.height);
+    board->setVoxelField(voxel.enabled);
+    board->setDynamicResolution(resolution);
+    int result = 0;
+    if (stress.enabled) {
+        board->startGame();
+        result = StressTest::run(nullptr, *board, stress);
+    } else if (!headless.record.empty()) {
+        result = recordDemo(headless.record, stress.frames);
+    } else if (StressTest::fillPattern(*board, stress.pattern)) {
+        glClearColor(0.96f, 0.91f, 0.94f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        board->render();
+        RenderBackend::current().endFrame();
+    } else {
+        std::cout << "Motif inconnu : " << stress.pattern << std::endl;
+        result = 1;
+    }
+    // La capture montre la dernière image rendue
+    if (result == 0 && !headless.screenshot.empty() && !context.writeScreenshot(headless.screenshot)) result = 1;
+
+    delete board;
+    board = nullptr;
+    return result;
+}
+
+// Fenêtre de surveillance : N parties de l'Autoplayer, rendues à chaque tick
+int runMosaic(const Mosaic::Options& mosaicOptions, const FramePacer::Options& pacing) {
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+    Mosaic mosaic(mosaicOptions.boards, width, height);
+    activeMosaic = &mosaic;
+    ShaderRegistry::startWatching();
+    RenderScheduler renderScheduler(window);
+    scheduler = &renderScheduler;
+    FramePacer pacer(window, pacing);
+    framePacer = &pacer;
+
+    auto lastTime = std::chrono::high_resolution_clock::now();
+    while (!glfwWindowShouldClose(window)) {
+        PROFILE_ZONE("frame");
+        pacer.beginWork();
+        auto currentTime = std::chrono::high_resolution_clock::now();
+        float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
+        lastTime = currentTime;
+        if (ShaderRegistry::reloadChanged() > 0) scheduler->requestRedraw();
+        mosaic.update(deltaTime);
+
+        scheduler->setContinuous(pacing.continuous || GlStats::isEnabled());
+        if (scheduler->shouldRender(mosaic.getRevision())) {
+            glClearColor(0.96f, 0.91f, 0.94f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            mosaic.render();
+            RenderBackend::current().endFrame();
+            GlStats::endFrame();
+            pacer.endWork();
+            pacer.waitForPresent();
+            glfwSwapBuffers(window);
+            pacer.framePresented();
+            scheduler->rendered(mosaic.getRevision());
+        }
+        if (scheduler->isContinuous()) {
+            pacer.waitForFrameStart();
+            glfwPollEvents();
+        } else {
+            scheduler->waitEvents(mosaic.getNextTickDelay(), mosaic.getRevision());
+        }
+    }
+
+    std::cout << "Mosaïque : " << mosaic.getGamesPlayed() << " parties terminées" << std::endl;
+    activeMosaic = nullptr;
+    framePacer = nullptr;
+    scheduler = nullptr;
+    ShaderRegistry::stopWatching();
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    PROFILE_THREAD_NAME("main");
+    FramePacer::Options pacing;
+    HeadlessContext::Options headless;
+    StressTest::Options stress;
+    Mosaic::Options mosaicOptions;
+    VoxelField::Options voxel;
+    DynamicResolution::Options resolution;
+    if (!FramePacer::parseArguments(argc, argv, pacing) || !HeadlessContext::parseArguments(argc, argv, headless) ||
+        !Mosaic::parseArguments(argc, argv, mosaicOptions) || !VoxelField::parseArguments(argc, argv, voxel) ||
+        !DynamicResolution::parseArguments(argc, argv, resolution) || !StressTest::parseArguments(argc, argv, stress)) {
+        StressTest::printUsage();
+        FramePacer::printUsage();
+        HeadlessContext::printUsage();
+        Mosaic::printUsage();
+        VoxelField::printUsage();
+        DynamicResolution::printUsage();
+        return 1;
+    }
+    if (headless.enabled) return runHeadless(headless, stress, mosaicOptions, voxel, resolution);
+
     glfwInit();
+    StartupReport::mark("glfwInit");
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -79,54 +320,185 @@ int main() {
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetKeyCallback(window, key_callback);
+    glfwSetWindowRefreshCallback(window, window_refresh_callback);
+    StartupReport::mark("fenêtre et contexte");
 
     // Chargement de l'icône personnalisée
     setWindowIcon(window, "../icon.png");
+    StartupReport::mark("icône");
 
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cout << "Échec de l'initialisation de GLAD" << std::endl;
         return -1;
     }
+    StartupReport::mark("GLAD");
 
     glEnable(GL_DEPTH_TEST);
+    // Écrans haute densité : le framebuffer n'a pas la taille de la fenêtre
+    int framebufferWidth, framebufferHeight;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    
+    if (mosaicOptions.boards > 0) {
+        int result = runMosaic(mosaicOptions, pacing);
+        glfwTerminate();
+        return result;
+    }
+    
+    if (stress.enabled) {
+        board = new Board(stress.width, stress.height);
+        board->setVoxelField(voxel.enabled);
+        board->setDynamicResolution(resolution);
+        board->setViewportSize(framebufferWidth, framebufferHeight);
+        board->startGame();
+        int result = StressTest::run(window, *board, stress);
+        delete board;
+        glfwTerminate();
+        return result;
+    }
     
     board = new Board();
+    board->setVoxelField(voxel.enabled);
+    board->setDynamicResolution(resolution);
+    board->setViewportSize(framebufferWidth, framebufferHeight);
+    StartupReport::mark("Board : reste");
+
+    const ShaderCache::Stats& shaders = ShaderCache::getStats();
+    std::cout << "Shaders : " << shaders.loaded << " depuis le cache, " << shaders.compiled
+              << " compilés (" << shaders.milliseconds << " ms)";
+    if (shaders.rejected) std::cout << ", " << shaders.rejected << " entrées invalides recompilées";
+    std::cout << std::endl;
+    ShaderRegistry::startWatching();
+    RenderScheduler renderScheduler(window);
+    scheduler = &renderScheduler;
+    FramePacer pacer(window, pacing);
+    framePacer = &pacer;
+    FrameCapture frameCapture;
+    capture = &frameCapture;
 
     auto lastTime = std::chrono::high_resolution_clock::now();
     float dropTimer = 0.0f;
     
     const float normalSpeed = 0.4f;
     const float fastSpeed = 0.05f;
+    const float autoplayInterval = 0.05f;
+    
+    // La recherche tourne pendant la chute de la pièce, hors du thread de rendu
+    Ponderer ponderer;
+    StartupReport::mark("Ponderer");
+    unsigned lastSpawn = 0;
+    uint64_t ponderKey = 0;
+    bool hasPlacement = false;
+    Autoplayer::Placement placement;
+    float autoplayTimer = 0.0f;
+    int autoplaySteps = 0;
+    bool autoplayDropping = false;
 
     // La boucle principale du jeu 
     while (!glfwWindowShouldClose(window)) {
+        PROFILE_ZONE("frame");
+        pacer.beginWork();
         auto currentTime = std::chrono::high_resolution_clock::now();
         float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
+        board->setFrameTime(deltaTime * 1000.0f);
+        if (ShaderRegistry::reloadChanged() > 0) scheduler->requestRedraw();
 
-        if (board->getGameState() == GameState::PLAYING) {
+        const Simulation& simulation = board->getSimulation();
+        if (board->getGameState() != GameState::PLAYING) {
+            lastSpawn = 0;
+        } else if (simulation.getSpawnCount() != lastSpawn) {
+            lastSpawn = simulation.getSpawnCount();
+            ponderKey = ponderer.submit(simulation);
+            hasPlacement = false;
+            autoplaySteps = 0;
+            autoplayDropping = false;
+        }
+        if (!hasPlacement && lastSpawn != 0) hasPlacement = ponderer.getResult(ponderKey, placement);
+        board->setHint(showHint && hasPlacement ? &placement : nullptr);
+        
+        // Délai avant le prochain événement non déclenché par une entrée (< 0 : aucun)
+        double nextDeadline = -1.0;
+        
+        if (board->getGameState() != GameState::PLAYING) {
+            // Sinon l'attente en écran d'accueil compterait comme de la chute
+            dropTimer = 0.0f;
+        } else {
             dropTimer += deltaTime;
             
+            if (autoplay && hasPlacement && !autoplayDropping) {
+                autoplayTimer += deltaTime;
+                if (autoplayTimer >= autoplayInterval) {
+                    autoplayTimer = 0.0f;
+                    autoplayDropping = stepAutoplay(placement, autoplaySteps);
+                }
+            }
+            
             // Vitesse rapide si on appuie sur S ou flèche du bas
             bool fastDrop = (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS || 
-                           glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS);
+                           glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) ||
+                           (autoplay && autoplayDropping);
             
             float currentSpeed = fastDrop ? fastSpeed : normalSpeed;
             
             if (dropTimer >= currentSpeed) {
+                PROFILE_ZONE("Board::update");
                 board->update();
                 dropTimer = 0.0f;
             }
+            
+            nextDeadline = currentSpeed - dropTimer;
+            if (autoplay && hasPlacement && !autoplayDropping) {
+                nextDeadline = std::min(nextDeadline, static_cast<double>(autoplayInterval - autoplayTimer));
+            }
+            // Résultat du Ponderer attendu : il n'émet aucun événement, on le guette
+            if ((autoplay || showHint) && !hasPlacement) nextDeadline = std::min(nextDeadline, 0.01);
         }
 
-        glClearColor(0.96f, 0.91f, 0.94f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // Les overlays affichent des temps d'image et une vidéo a besoin de
+        // toutes ses images : ils imposent un rendu continu
+        scheduler->setContinuous(pacing.continuous || board->isPerfOverlayVisible() ||
+                                 GlStats::isEnabled() || frameCapture.isRecording());
+        if (scheduler->shouldRender(board->getRevision())) {
+            if (board->isPerfOverlayVisible()) board->setTableStats(ponderer.getTableStats());
+            glClearColor(0.96f, 0.91f, 0.94f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        board->render();
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            {
+                PROFILE_ZONE("Board::render");
+                board->render();
+            }
+            RenderBackend::current().endFrame();
+            GlStats::endFrame();
+            frameCapture.captureFrame();
+            pacer.endWork();
+            pacer.waitForPresent();
+            {
+                PROFILE_ZONE("glfwSwapBuffers");
+                glfwSwapBuffers(window);
+            }
+            pacer.framePresented();
+            scheduler->rendered(board->getRevision());
+            StartupReport::firstFramePresented();
+        }
+        if (scheduler->isContinuous()) {
+            // Entrées lues au dernier instant sûr avant l'image suivante
+            {
+                PROFILE_ZONE("FramePacer::wait");
+                pacer.waitForFrameStart();
+            }
+            PROFILE_ZONE("glfwPollEvents");
+            glfwPollEvents();
+        } else {
+            PROFILE_ZONE("glfwWaitEvents");
+            scheduler->waitEvents(nextDeadline, board->getRevision());
+        }
     }
 
+    frameCapture.stop();
+    capture = nullptr;
+    framePacer = nullptr;
+    scheduler = nullptr;
+    ShaderRegistry::stopWatching();
     delete board;
     glfwTerminate();
     return 0;
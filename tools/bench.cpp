@@ -0,0 +1,534 @@
+// Benchmarks reproductibles (graines fixes) des chemins chauds de la
+// simulation et du rendu. Chaque mesure est répétée et le résultat écrit en
+// JSON pour comparer deux builds :
+//   ./Tetris3D_bench --out avant.json
+// Sans serveur d'affichage, le rendu passe par un contexte EGL headless ; les
+// mesures de rendu ne sont ignorées que si aucun contexte OpenGL n'est disponible.
+// Les mesures render_null/* passent par NullBackend et ne demandent aucun contexte.
+#include "Autoplayer.h"
+#include "Board.h"
+#include "GlStats.h"
+#include "HeadlessContext.h"
+#include "Mosaic.h"
+#include "NeuralEvaluator.h"
+#include "NullBackend.h"
+#include "Simulation.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef TETRIS3D_BUILD_TYPE
+#define TETRIS3D_BUILD_TYPE ""
+#endif
+
+struct Options {
+    std::string out;
+    std::string filter;
+    int repetitions = 5;
+    double minTime = 0.1;
+    bool render = true;
+};
+
+struct Result {
+    std::string name;
+    std::string skipped;
+    long long iterations = 0;
+    std::vector<double> nsPerOp;
+    std::map<std::string, double> counters;
+};
+
+// Exécute iterations fois l'opération mesurée et retourne la durée en nanosecondes
+typedef std::function<double(long long iterations)> Body;
+
+static volatile long long sink = 0;
+
+static double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) options.out = argv[++i];
+        else if (arg == "--filter" && hasValue) options.filter = argv[++i];
+        else if (arg == "--repetitions" && hasValue) options.repetitions = std::atoi(argv[++i]);
+        else if (arg == "--min-time" && hasValue) options.minTime = std::atof(argv[++i]);
+        else if (arg == "--no-render") options.render = false;
+        else return false;
+    }
+    return options.repetitions > 0 && options.minTime > 0.0;
+}
+
+class Runner {
+public:
+    explicit Runner(const Options& options) : options(options) {}
+
+    bool selected(const std::string& name) const {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    }
+
+    // Double le nombre d'itérations jusqu'à atteindre minTime, puis répète la mesure
+    Result* run(const std::string& name, const Body& body) {
+        if (!selected(name)) return nullptr;
+        std::cerr << name << "..." << std::flush;
+
+        long long iterations = 1;
+        while (body(iterations) < options.minTime * 1e9 && iterations < (1LL << 40)) iterations *= 2;
+
+        Result result;
+        result.name = name;
+        result.iterations = iterations;
+        for (int r = 0; r < options.repetitions; r++) {
+            result.nsPerOp.push_back(body(iterations) / iterations);
+        }
+        results.push_back(result);
+
+        std::vector<double> sorted = result.nsPerOp;
+        std::sort(sorted.begin(), sorted.end());
+        std::cerr << " " << sorted[sorted.size() / 2] << " ns/op" << std::endl;
+        return &results.back();
+    }
+
+    void skip(const std::string& name, const std::string& reason) {
+        if (!selected(name)) return;
+        Result result;
+        result.name = name;
+        result.skipped = reason;
+        results.push_back(result);
+        std::cerr << name << " ignoré : " << reason << std::endl;
+    }
+
+    std::string toJson(const std::string& glRenderer) const;
+
+private:
+    const Options& options;
+    std::vector<Result> results;
+};
+
+static std::string jsonString(const std::string& text) {
+    std::string escaped = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+    }
+    return escaped + "\"";
+}
+
+std::string Runner::toJson(const std::string& glRenderer) const {
+    std::ostringstream out;
+    out.precision(6);
+    out << "{\n  \"context\": {\n";
+    out << "    \"build_type\": " << jsonString(TETRIS3D_BUILD_TYPE) << ",\n";
+#ifdef __VERSION__
+    out << "    \"compiler\": " << jsonString(__VERSION__) << ",\n";
+#endif
+    out << "    \"simd\": " << jsonString(NeuralEvaluator::simdName()) << ",\n";
+    out << "    \"repetitions\": " << options.repetitions << ",\n";
+    out << "    \"gl_renderer\": " << (glRenderer.empty() ? "null" : jsonString(glRenderer)) << "\n";
+    out << "  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": " << jsonString(result.name);
+        if (!result.skipped.empty()) {
+            out << ", \"skipped\": " << jsonString(result.skipped) << "}";
+            continue;
+        }
+        std::vector<double> sorted = result.nsPerOp;
+        std::sort(sorted.begin(), sorted.end());
+        out << ", \"iterations\": " << result.iterations
+            << ", \"ns_per_op\": {\"median\": " << sorted[sorted.size() / 2]
+            << ", \"min\": " << sorted.front() << ", \"max\": " << sorted.back() << "}";
+        if (!result.counters.empty()) {
+            out << ", \"counters\": {";
+            bool first = true;
+            for (const auto& counter : result.counters) {
+                out << (first ? "" : ", ") << jsonString(counter.first) << ": " << counter.second;
+                first = false;
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+// Plateau rempli par motif : une case vide par ligne, à une colonne pseudo-aléatoire
+static void fillRows(Simulation& simulation, int rows, uint64_t seed) {
+    std::mt19937 rng(static_cast<std::mt19937::result_type>(seed));
+    int width = simulation.getWidth();
+    for (int y = 0; y < rows && y < simulation.getHeight(); y++) {
+        int hole = std::uniform_int_distribution<int>(0, width - 1)(rng);
+        for (int x = 0; x < width; x++) {
+            uint8_t type = static_cast<uint8_t>((x + y) % Simulation::PIECE_COUNT) + 1;
+            simulation.setCell(x, y, x == hole ? 0 : type);
+        }
+    }
+}
+
+// Positions réalistes : celles rencontrées par l'heuristique en jouant
+static std::vector<std::vector<uint8_t>> collectBoards(int count) {
+    std::vector<std::vector<uint8_t>> boards;
+    Autoplayer player;
+    for (uint64_t seed = 1; static_cast<int>(boards.size()) < count; seed++) {
+        Simulation simulation(Simulation::DEFAULT_WIDTH, Simulation::DEFAULT_HEIGHT, seed);
+        simulation.start();
+        while (simulation.getGameState() == GameState::PLAYING && static_cast<int>(boards.size()) < count) {
+            player.applyPlacement(simulation, player.findBestPlacement(simulation));
+            const uint8_t* cells = simulation.getCells();
+            boards.emplace_back(cells, cells + simulation.getWidth() * simulation.getHeight());
+        }
+    }
+    return boards;
+}
+
+static void runSimulationBenchmarks(Runner& runner) {
+    const int width = Simulation::DEFAULT_WIDTH;
+    const int height = Simulation::DEFAULT_HEIGHT;
+
+    runner.run("simulation/is_valid_position", [&](long long iterations) {
+        Simulation simulation(width, height, 1);
+        fillRows(simulation, height / 2, 1);
+        simulation.start();
+        // Quelques décalages de la pièce courante, valides ou non
+        std::vector<std::vector<glm::vec2>> candidates;
+        for (int dx = -4; dx < 4; dx++) {
+            for (int dy = 0; dy > -16; dy -= 2) {
+                std::vector<glm::vec2> positions = simulation.getCurrentPiece()->getBlockPositions();
+                for (glm::vec2& p : positions) p += glm::vec2(dx, dy);
+                candidates.push_back(positions);
+            }
+        }
+        long long valid = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            valid += simulation.isValidPosition(candidates[i % candidates.size()]);
+        }
+        double ns = elapsedNs(start);
+        sink += valid;
+        return ns;
+    });
+
+    // Une rotation contre le mur de gauche (les décalages de kick sont essayés)
+    // suivie du retour au mur
+    runner.run("simulation/rotate_with_kicks", [&](long long iterations) {
+        Simulation simulation(width, height, 2);
+        simulation.start();
+        for (int i = 0; i < width; i++) simulation.moveCurrentPiece(-1, 0);
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            simulation.rotateCurrentPiece();
+            simulation.moveCurrentPiece(-1, 0);
+        }
+        double ns = elapsedNs(start);
+        sink += simulation.getCurrentPiece()->getRotation();
+        return ns;
+    });
+
+    // Base : ligne du bas pleine sauf les cases où la pièce courante va se poser
+    Simulation lockBase(width, height, 3);
+    lockBase.start();
+    {
+        const Piece* piece = lockBase.getCurrentPiece();
+        glm::ivec2 blocks[4];
+        Autoplayer::landingBlocks(lockBase.getCells(), width, height, piece->getType(),
+                                  piece->getRotation(), static_cast<int>(piece->getX()), blocks);
+        for (int x = 0; x < width; x++) lockBase.setCell(x, 0, 1);
+        for (const glm::ivec2& block : blocks) {
+            if (block.y == 0) lockBase.setCell(block.x, 0, 0);
+        }
+    }
+
+    runner.run("simulation/copy", [&](long long iterations) {
+        Simulation simulation;
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) simulation = lockBase;
+        double ns = elapsedNs(start);
+        sink += simulation.getSpawnCount();
+        return ns;
+    });
+
+    // Copie de la base (voir simulation/copy) puis pose et effacement des lignes
+    Result* lock = runner.run("simulation/lock_clear", [&](long long iterations) {
+        Simulation simulation;
+        long long lines = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            simulation = lockBase;
+            simulation.hardDrop();
+            lines += simulation.getLinesCleared();
+        }
+        double ns = elapsedNs(start);
+        sink += lines;
+        return ns;
+    });
+    if (lock) {
+        Simulation simulation = lockBase;
+        simulation.hardDrop();
+        lock->counters["lines_per_op"] = simulation.getLinesCleared();
+    }
+
+    // Même générateur et même distribution que Simulation
+    runner.run("rng/piece", [&](long long iterations) {
+        std::mt19937 rng(4);
+        std::uniform_int_distribution<int> pieceDist(0, Simulation::PIECE_COUNT - 1);
+        long long total = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) total += pieceDist(rng);
+        double ns = elapsedNs(start);
+        sink += total;
+        return ns;
+    });
+}
+
+static void runAutoplayerBenchmarks(Runner& runner) {
+    const int width = Simulation::DEFAULT_WIDTH;
+    const int height = Simulation::DEFAULT_HEIGHT;
+    std::vector<std::vector<uint8_t>> boards = collectBoards(256);
+    Autoplayer player;
+
+    runner.run("autoplayer/evaluate", [&](long long iterations) {
+        float total = 0.0f;
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            total += player.evaluate(boards[i % boards.size()].data(), width, height, 0);
+        }
+        double ns = elapsedNs(start);
+        sink += static_cast<long long>(total);
+        return ns;
+    });
+
+    Simulation position(width, height, 5);
+    position.start();
+    fillRows(position, 6, 5);
+    runner.run("autoplayer/find_best_placement", [&](long long iterations) {
+        int total = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) total += player.findBestPlacement(position).x;
+        double ns = elapsedNs(start);
+        sink += total;
+        return ns;
+    });
+
+    const int maxPieces = 500;
+    long long pieces = 0;
+    long long games = 0;
+    Result* game = runner.run("game/headless", [&](long long iterations) {
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            Simulation simulation(width, height, 1000 + i);
+            simulation.start();
+            pieces += player.playGame(simulation, maxPieces);
+            games++;
+        }
+        return elapsedNs(start);
+    });
+    if (game && games > 0) {
+        std::vector<double> sorted = game->nsPerOp;
+        std::sort(sorted.begin(), sorted.end());
+        game->counters["max_pieces"] = maxPieces;
+        game->counters["pieces_per_game"] = static_cast<double>(pieces) / games;
+        game->counters["games_per_second"] = 1e9 / sorted[sorted.size() / 2];
+    }
+
+    // Profondeur 2 avec table, comme le Ponderer ; la table est gardée d'une
+    // partie à l'autre (graines toutes différentes) et les compteurs sont ceux
+    // de la dernière répétition
+    const int deepPieces = 100;
+    TranspositionTable table;
+    Autoplayer deepPlayer(Autoplayer::defaultWeights(), 2);
+    deepPlayer.setTranspositionTable(&table);
+    long long deepGames = 0;
+    Result* deep = runner.run("game/headless_depth2_tt", [&](long long iterations) {
+        table.resetStats();
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            Simulation simulation(width, height, 2000 + deepGames++);
+            simulation.start();
+            table.newSearch();
+            sink += deepPlayer.playGame(simulation, deepPieces);
+        }
+        return elapsedNs(start);
+    });
+    if (deep) {
+        TranspositionTable::Stats stats = table.getStats();
+        deep->counters["max_pieces"] = deepPieces;
+        deep->counters["tt_hit_rate"] = stats.hitRate();
+        deep->counters["tt_occupancy"] = stats.occupancy();
+    }
+}
+
+// Coût CPU de Board::render sans pilote : les commandes sont enregistrées par
+// NullBackend au lieu d'être envoyées à OpenGL
+static void runNullRenderBenchmarks(Runner& runner) {
+    const char* names[] = {"render_null/empty", "render_null/half", "render_null/full"};
+    const int rows[] = {0, 10, 20};
+
+    bool wanted = runner.selected("render_null/mosaic_256");
+    for (const char* name : names) wanted = wanted || runner.selected(name);
+    if (!wanted) return;
+
+    NullBackend backend;
+    RenderBackend::setCurrent(&backend);
+    for (int i = 0; i < 3; i++) {
+        Board* board = new Board();
+        fillRows(board->getSimulation(), rows[i], 6);
+        Result* result = runner.run(names[i], [&](long long iterations) {
+            auto start = std::chrono::steady_clock::now();
+            for (long long frame = 0; frame < iterations; frame++) {
+                backend.clear();
+                board->render();
+                backend.endFrame();
+            }
+            return elapsedNs(start);
+        });
+        if (result) {
+            using CommandType = NullBackend::CommandType;
+            result->counters["commands_per_frame"] = static_cast<double>(backend.getCommands().size());
+            result->counters["draws_per_frame"] = static_cast<double>(
+                backend.getCount(CommandType::DRAW_ARRAYS) + backend.getCount(CommandType::DRAW_ELEMENTS) +
+                backend.getCount(CommandType::DRAW_ELEMENTS_INSTANCED) +
+                backend.getCount(CommandType::MULTI_DRAW_ELEMENTS_INDIRECT));
+            result->counters["uniforms_per_frame"] = static_cast<double>(backend.getCount(CommandType::SET_UNIFORM));
+        }
+        delete board;
+    }
+
+    // Mosaïque de 256 parties : le nombre de draw calls ne dépend pas du nombre de parties
+    if (runner.selected("render_null/mosaic_256")) {
+        Mosaic* mosaic = new Mosaic(Mosaic::MAX_BOARDS, 1200, 900);
+        mosaic->advance(400);
+        Result* result = runner.run("render_null/mosaic_256", [&](long long iterations) {
+            auto start = std::chrono::steady_clock::now();
+            for (long long frame = 0; frame < iterations; frame++) {
+                backend.clear();
+                mosaic->render();
+                backend.endFrame();
+            }
+            return elapsedNs(start);
+        });
+        if (result) {
+            using CommandType = NullBackend::CommandType;
+            result->counters["cubes_per_frame"] = static_cast<double>(mosaic->getInstanceCount());
+            result->counters["draws_per_frame"] = static_cast<double>(
+                backend.getCount(CommandType::DRAW_ARRAYS) + backend.getCount(CommandType::DRAW_ELEMENTS) +
+                backend.getCount(CommandType::DRAW_ELEMENTS_INSTANCED));
+        }
+        delete mosaic;
+    }
+    RenderBackend::setCurrent(nullptr);
+}
+
+// Temps CPU de soumission de Board::render ; glFinish hors mesure pour que
+// la file de commandes du pilote ne s'allonge pas
+static void runRenderBenchmarks(Runner& runner, std::string& glRenderer) {
+    const char* names[] = {"render/empty", "render/half", "render/full"};
+    const int rows[] = {0, 10, 20};
+
+    bool wanted = false;
+    for (const char* name : names) wanted = wanted || runner.selected(name);
+    if (!wanted) return;
+
+    GLFWwindow* window = nullptr;
+    if (glfwInit()) {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        window = glfwCreateWindow(1200, 900, "Tetris 3D bench", NULL, NULL);
+    }
+    HeadlessContext headless;
+    if (window) {
+        glfwMakeContextCurrent(window);
+        glfwSwapInterval(0);
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+            for (const char* name : names) runner.skip(name, "échec du chargement de GLAD");
+            glfwDestroyWindow(window);
+            glfwTerminate();
+            return;
+        }
+    } else if (!headless.create(1200, 900)) {
+        for (const char* name : names) runner.skip(name, "aucun contexte OpenGL");
+        glfwTerminate();
+        return;
+    }
+    glRenderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    glViewport(0, 0, 1200, 900);
+    glEnable(GL_DEPTH_TEST);
+
+    for (int i = 0; i < 3; i++) {
+        Board* board = new Board();
+        fillRows(board->getSimulation(), rows[i], 6);
+        GlStats::enable("");
+        Result* result = runner.run(names[i], [&](long long iterations) {
+            double ns = 0.0;
+            for (long long frame = 0; frame < iterations; frame++) {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                auto start = std::chrono::steady_clock::now();
+                board->render();
+                ns += elapsedNs(start);
+                RenderBackend::current().endFrame();
+                GlStats::endFrame();
+                glFinish();
+            }
+            return ns;
+        });
+        if (result) {
+            // Appels qui atteignent le pilote, une fois filtrés par l'état connu de GlBackend
+            const GlStats::Counters& counters = GlStats::lastFrame();
+            result->counters["draws_per_frame"] = counters.drawCalls;
+            result->counters["program_binds_per_frame"] = counters.programBinds;
+            result->counters["vao_binds_per_frame"] = counters.vaoBinds;
+            result->counters["uniforms_per_frame"] = counters.uniformUpdates;
+            result->counters["uniform_lookups_per_frame"] = counters.uniformLookups;
+        }
+        GlStats::disable();
+        delete board;
+    }
+
+    if (window) glfwDestroyWindow(window);
+    glfwTerminate();
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cout << "Usage: Tetris3D_bench [--out FICHIER] [--filter TEXTE] [--repetitions N]\n"
+                  << "                      [--min-time S] [--no-render]" << std::endl;
+        return 1;
+    }
+
+    Runner runner(options);
+    std::string glRenderer;
+    runSimulationBenchmarks(runner);
+    runAutoplayerBenchmarks(runner);
+    runNullRenderBenchmarks(runner);
+    if (options.render) runRenderBenchmarks(runner, glRenderer);
+
+    std::string json = runner.toJson(glRenderer);
+    if (options.out.empty()) {
+        std::cout << json;
+        return 0;
+    }
+    std::ofstream out(options.out);
+    out << json;
+    if (!out) {
+        std::cout << "Impossible d'écrire " << options.out << std::endl;
+        return 1;
+    }
+    std::cerr << "Résultats écrits dans " << options.out << std::endl;
+    return 0;
+}
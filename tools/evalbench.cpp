@@ -0,0 +1,183 @@
+// Compare l'évaluateur neuronal quantifié à l'heuristique de l'Autoplayer :
+// concordance SIMD / scalaire, plateaux évalués par seconde sur un coeur et
+// force de jeu sur des parties headless avec les mêmes graines.
+#include "Autoplayer.h"
+#include "NeuralEvaluator.h"
+#include "Simulation.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct Options {
+    std::string weights;
+    std::string save;
+    int hidden = 32;
+    int games = 20;
+    int maxPieces = 500;
+    double seconds = 1.0;
+};
+
+struct Batch {
+    std::vector<uint8_t> boards;
+    int count = 0;
+};
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--weights" && hasValue) options.weights = argv[++i];
+        else if (arg == "--save" && hasValue) options.save = argv[++i];
+        else if (arg == "--hidden" && hasValue) options.hidden = std::atoi(argv[++i]);
+        else if (arg == "--games" && hasValue) options.games = std::atoi(argv[++i]);
+        else if (arg == "--max-pieces" && hasValue) options.maxPieces = std::atoi(argv[++i]);
+        else if (arg == "--seconds" && hasValue) options.seconds = std::atof(argv[++i]);
+        else return false;
+    }
+    return options.hidden > 0 && options.games >= 0 && options.seconds > 0.0;
+}
+
+// Positions réalistes : celles rencontrées par l'heuristique en jouant
+static std::vector<Batch> collectBatches(int width, int height, int wanted) {
+    std::vector<Batch> batches;
+    Autoplayer player;
+    const int cellCount = width * height;
+
+    for (uint64_t seed = 1; static_cast<int>(batches.size()) < wanted; seed++) {
+        Simulation simulation(width, height, seed);
+        simulation.start();
+        while (simulation.getGameState() == GameState::PLAYING && static_cast<int>(batches.size()) < wanted) {
+            Batch batch;
+            batch.boards.resize(static_cast<size_t>(NeuralEvaluator::MAX_BATCH) * cellCount);
+            PieceType piece = simulation.getCurrentPiece()->getType();
+            for (int rotation = 0; rotation < 4; rotation++) {
+                for (int x = 0; x < width && batch.count < NeuralEvaluator::MAX_BATCH; x++) {
+                    uint8_t* board = batch.boards.data() + static_cast<size_t>(batch.count) * cellCount;
+                    std::memcpy(board, simulation.getCells(), cellCount);
+                    if (Autoplayer::dropPiece(board, width, height, piece, rotation, x) >= 0) batch.count++;
+                }
+            }
+            if (batch.count > 0) batches.push_back(std::move(batch));
+            player.applyPlacement(simulation, player.findBestPlacement(simulation));
+        }
+    }
+    return batches;
+}
+
+template <typename Evaluate>
+static double measureBoardsPerSecond(const std::vector<Batch>& batches, double seconds, Evaluate evaluate) {
+    long long boards = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    while (elapsed < seconds) {
+        for (const Batch& batch : batches) {
+            evaluate(batch);
+            boards += batch.count;
+        }
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    return boards / elapsed;
+}
+
+static void playGames(const char* label, const NeuralEvaluator* evaluator, const Options& options) {
+    long long lines = 0;
+    long long pieces = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int game = 0; game < options.games; game++) {
+        Simulation simulation(Simulation::DEFAULT_WIDTH, Simulation::DEFAULT_HEIGHT, 1000 + game);
+        simulation.start();
+        Autoplayer player;
+        player.setNeuralEvaluator(evaluator);
+        pieces += player.playGame(simulation, options.maxPieces);
+        lines += simulation.getLinesCleared();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-22s %8.2f lignes/partie %10.0f pièces/s\n", label,
+                options.games ? static_cast<double>(lines) / options.games : 0.0, pieces / elapsed);
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cout << "Usage: Tetris3D_evalbench [--weights FICHIER] [--save FICHIER] [--hidden N]\n"
+                  << "                          [--games N] [--max-pieces N] [--seconds S]" << std::endl;
+        return 1;
+    }
+
+    const int width = Simulation::DEFAULT_WIDTH;
+    const int height = Simulation::DEFAULT_HEIGHT;
+
+    NeuralEvaluator evaluator;
+    if (!options.weights.empty()) {
+        if (!evaluator.load(options.weights)) return 1;
+        if (!evaluator.accepts(width, height)) {
+            std::cout << "Les poids ne correspondent pas à un plateau " << width << "x" << height << std::endl;
+            return 1;
+        }
+    } else {
+        std::cout << "Aucun fichier de poids : réseau aléatoire (mesure de débit uniquement)" << std::endl;
+        evaluator = NeuralEvaluator::createRandom(width, height, options.hidden, 1);
+    }
+    if (!options.save.empty() && !evaluator.save(options.save)) {
+        std::cout << "Impossible d'écrire " << options.save << std::endl;
+    }
+    std::cout << "Réseau " << evaluator.getInputCount() << " -> " << evaluator.getHiddenCount()
+              << " -> 1, SIMD : " << NeuralEvaluator::simdName() << std::endl;
+
+    std::vector<Batch> batches = collectBatches(width, height, 256);
+
+    // Les deux chemins doivent donner des sorties identiques au bit près
+    NeuralEvaluator scalar = evaluator;
+    scalar.setUseSimd(false);
+    NeuralEvaluator simd = evaluator;
+    simd.setUseSimd(true);
+    long long mismatches = 0;
+    long long compared = 0;
+    for (const Batch& batch : batches) {
+        float a[NeuralEvaluator::MAX_BATCH];
+        float b[NeuralEvaluator::MAX_BATCH];
+        scalar.evaluateBatch(batch.boards.data(), batch.count, a);
+        simd.evaluateBatch(batch.boards.data(), batch.count, b);
+        for (int i = 0; i < batch.count; i++) {
+            if (std::memcmp(&a[i], &b[i], sizeof(float)) != 0) mismatches++;
+            compared++;
+        }
+    }
+    std::cout << "Concordance SIMD/scalaire : " << compared - mismatches << "/" << compared << std::endl;
+
+    Autoplayer heuristic;
+    // Empêche le compilateur d'éliminer les évaluations mesurées
+    volatile float sink = 0.0f;
+    double heuristicRate = measureBoardsPerSecond(batches, options.seconds, [&](const Batch& batch) {
+        for (int i = 0; i < batch.count; i++) {
+            sink += heuristic.evaluate(batch.boards.data() + static_cast<size_t>(i) * width * height,
+                                       width, height, 0);
+        }
+    });
+    float scores[NeuralEvaluator::MAX_BATCH];
+    double scalarRate = measureBoardsPerSecond(batches, options.seconds, [&](const Batch& batch) {
+        scalar.evaluateBatch(batch.boards.data(), batch.count, scores);
+        sink += scores[0];
+    });
+    double simdRate = measureBoardsPerSecond(batches, options.seconds, [&](const Batch& batch) {
+        simd.evaluateBatch(batch.boards.data(), batch.count, scores);
+        sink += scores[0];
+    });
+
+    std::printf("\nDébit par coeur (plateaux/s)\n");
+    std::printf("%-22s %12.0f  (%.1f ns/plateau)\n", "heuristique", heuristicRate, 1e9 / heuristicRate);
+    std::printf("%-22s %12.0f  (%.1f ns/plateau)\n", "réseau scalaire", scalarRate, 1e9 / scalarRate);
+    std::printf("%-22s %12.0f  (%.1f ns/plateau)\n", "réseau SIMD", simdRate, 1e9 / simdRate);
+
+    if (options.games > 0) {
+        std::printf("\nForce de jeu (%d parties, %d pièces max)\n", options.games, options.maxPieces);
+        playGames("heuristique", nullptr, options);
+        playGames("réseau SIMD", &simd, options);
+    }
+
+    return mismatches == 0 ? 0 : 1;
+}
\ No newline at end of file
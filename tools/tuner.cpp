@@ -0,0 +1,314 @@
+// Réglage hors ligne des poids heuristiques de l'Autoplayer par algorithme
+// génétique. Chaque génération joue des parties headless avec les mêmes
+// graines pour tous les individus, réparties sur tous les coeurs.
+#include "Autoplayer.h"
+#include "Simulation.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Options {
+    int population = 32;
+    int games = 8;
+    int generations = 50;
+    int maxPieces = 500;
+    int depth = 1;
+    int tableMegabytes = 64;
+    unsigned threads = std::thread::hardware_concurrency();
+    uint64_t seed = 1;
+    std::string checkpoint = "tuner_checkpoint.txt";
+    bool fresh = false;
+};
+
+struct Individual {
+    Autoplayer::Weights weights;
+    double fitness = 0.0;
+};
+
+struct TunerState {
+    int generation = 0;
+    unsigned long long totalGames = 0;
+    std::vector<Individual> population;
+    Individual best;
+    bool hasBest = false;
+    std::mt19937_64 rng;
+};
+
+static void printUsage() {
+    std::cout << "Usage: Tetris3D_tuner [--population N] [--games N] [--generations N]\n"
+              << "                      [--max-pieces N] [--depth N] [--threads N]\n"
+              << "                      [--table-mb N] [--seed N] [--checkpoint FICHIER] [--fresh]" << std::endl;
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--fresh") options.fresh = true;
+        else if (arg == "--population" && hasValue) options.population = std::atoi(argv[++i]);
+        else if (arg == "--games" && hasValue) options.games = std::atoi(argv[++i]);
+        else if (arg == "--generations" && hasValue) options.generations = std::atoi(argv[++i]);
+        else if (arg == "--max-pieces" && hasValue) options.maxPieces = std::atoi(argv[++i]);
+        else if (arg == "--depth" && hasValue) options.depth = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) options.threads = std::atoi(argv[++i]);
+        else if (arg == "--table-mb" && hasValue) options.tableMegabytes = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) options.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--checkpoint" && hasValue) options.checkpoint = argv[++i];
+        else return false;
+    }
+    return options.population >= 2 && options.games >= 1 && options.maxPieces >= 1 &&
+           options.tableMegabytes >= 0;
+}
+
+static void normalize(Autoplayer::Weights& weights) {
+    float norm = 0.0f;
+    for (float w : weights) norm += w * w;
+    norm = std::sqrt(norm);
+    if (norm > 0.0f) {
+        for (float& w : weights) w /= norm;
+    }
+}
+
+static std::string formatWeights(const Autoplayer::Weights& weights) {
+    std::ostringstream out;
+    for (size_t i = 0; i < weights.size(); i++) {
+        if (i > 0) out << ' ';
+        out << weights[i];
+    }
+    return out.str();
+}
+
+// Format texte : une ligne par entrée, l'état du générateur en dernier
+static bool saveCheckpoint(const std::string& path, const TunerState& state) {
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath);
+        if (!out) return false;
+        out.precision(9);
+        out << "generation " << state.generation << '\n';
+        out << "games " << state.totalGames << '\n';
+        if (state.hasBest) {
+            out << "best " << state.best.fitness << ' ' << formatWeights(state.best.weights) << '\n';
+        }
+        for (const Individual& individual : state.population) {
+            out << "individual " << formatWeights(individual.weights) << '\n';
+        }
+        out << "rng " << state.rng << '\n';
+        if (!out) return false;
+    }
+    return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+static bool loadCheckpoint(const std::string& path, TunerState& state) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    TunerState loaded;
+    std::string key;
+    while (in >> key) {
+        if (key == "generation") {
+            in >> loaded.generation;
+        } else if (key == "games") {
+            in >> loaded.totalGames;
+        } else if (key == "best") {
+            in >> loaded.best.fitness;
+            for (float& w : loaded.best.weights) in >> w;
+            loaded.hasBest = true;
+        } else if (key == "individual") {
+            Individual individual;
+            for (float& w : individual.weights) in >> w;
+            loaded.population.push_back(individual);
+        } else if (key == "rng") {
+            in >> loaded.rng;
+        } else {
+            return false;
+        }
+        if (!in) return false;
+    }
+    if (loaded.population.empty()) return false;
+
+    state = loaded;
+    return true;
+}
+
+static void initializePopulation(TunerState& state, const Options& options) {
+    state.rng.seed(options.seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    Individual reference;
+    reference.weights = Autoplayer::defaultWeights();
+    normalize(reference.weights);
+    state.population.push_back(reference);
+
+    while (static_cast<int>(state.population.size()) < options.population) {
+        Individual individual;
+        for (float& w : individual.weights) w = dist(state.rng);
+        normalize(individual.weights);
+        state.population.push_back(individual);
+    }
+}
+
+static const Individual& tournament(const std::vector<Individual>& population, std::mt19937_64& rng) {
+    std::uniform_int_distribution<size_t> pick(0, population.size() - 1);
+    const Individual* winner = &population[pick(rng)];
+    for (int i = 1; i < 3; i++) {
+        const Individual& challenger = population[pick(rng)];
+        if (challenger.fitness > winner->fitness) winner = &challenger;
+    }
+    return *winner;
+}
+
+// La population doit être triée par fitness décroissante
+static std::vector<Individual> breed(const std::vector<Individual>& population, const Options& options,
+                                     std::mt19937_64& rng) {
+    std::vector<Individual> next;
+    int eliteCount = std::max(1, options.population / 10);
+    for (int i = 0; i < eliteCount && i < static_cast<int>(population.size()); i++) {
+        next.push_back(population[i]);
+    }
+
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> noise(0.0f, 0.2f);
+    std::uniform_int_distribution<int> component(0, Autoplayer::FEATURE_COUNT - 1);
+
+    while (static_cast<int>(next.size()) < options.population) {
+        const Individual& a = tournament(population, rng);
+        const Individual& b = tournament(population, rng);
+
+        // Croisement pondéré par la fitness des deux parents
+        double fa = std::max(a.fitness, 0.0) + 1e-3;
+        double fb = std::max(b.fitness, 0.0) + 1e-3;
+        Individual child;
+        for (int i = 0; i < Autoplayer::FEATURE_COUNT; i++) {
+            child.weights[i] = static_cast<float>((a.weights[i] * fa + b.weights[i] * fb) / (fa + fb));
+        }
+        if (unit(rng) < 0.3f) child.weights[component(rng)] += noise(rng);
+        normalize(child.weights);
+        next.push_back(child);
+    }
+    return next;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    TunerState state;
+    if (!options.fresh && loadCheckpoint(options.checkpoint, state)) {
+        std::cout << "Reprise depuis " << options.checkpoint << " (génération "
+                  << state.generation << ")" << std::endl;
+        options.population = static_cast<int>(state.population.size());
+    } else {
+        initializePopulation(state, options);
+    }
+
+    WorkStealingPool pool(options.threads);
+
+    // Une seule table pour tous les workers : les clés étant salées par les
+    // poids, chaque individu ne relit que ses propres positions, y compris
+    // celles des autres parties qu'il joue en parallèle
+    std::unique_ptr<TranspositionTable> table;
+    if (options.tableMegabytes > 0) table.reset(new TranspositionTable(options.tableMegabytes));
+    std::cout << "Population " << options.population << ", " << options.games
+              << " parties par individu, " << pool.getThreadCount() << " threads" << std::endl;
+
+    auto runStart = std::chrono::steady_clock::now();
+    unsigned long long runGames = 0;
+
+    while (state.generation < options.generations) {
+        const int gamesPerGeneration = options.population * options.games;
+        std::vector<int> lines(gamesPerGeneration, 0);
+        uint64_t seedBase = options.seed * 1000003ULL + static_cast<uint64_t>(state.generation) * options.games;
+
+        // Une génération de la table par génération du tuner : avancée à chaque
+        // coup de chaque worker, elle ferait le tour de ses 256 valeurs en
+        // quelques parties et les âges comparés au remplacement n'auraient plus de sens
+        if (table) table->newSearch();
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < options.population; i++) {
+            for (int g = 0; g < options.games; g++) {
+                const Autoplayer::Weights weights = state.population[i].weights;
+                int slot = i * options.games + g;
+                uint64_t seed = seedBase + g;
+                int maxPieces = options.maxPieces;
+                int depth = options.depth;
+                TranspositionTable* shared = table.get();
+                pool.submit([&lines, weights, slot, seed, maxPieces, depth, shared] {
+                    Simulation simulation(Simulation::DEFAULT_WIDTH, Simulation::DEFAULT_HEIGHT, seed);
+                    simulation.start();
+                    Autoplayer player(weights, depth);
+                    player.setTranspositionTable(shared);
+                    player.playGame(simulation, maxPieces);
+                    lines[slot] = simulation.getLinesCleared();
+                });
+            }
+        }
+        pool.wait();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (int i = 0; i < options.population; i++) {
+            int total = std::accumulate(lines.begin() + i * options.games,
+                                        lines.begin() + (i + 1) * options.games, 0);
+            state.population[i].fitness = static_cast<double>(total) / options.games;
+        }
+        std::sort(state.population.begin(), state.population.end(),
+                  [](const Individual& a, const Individual& b) { return a.fitness > b.fitness; });
+
+        const Individual& leader = state.population.front();
+        if (!state.hasBest || leader.fitness > state.best.fitness) {
+            state.best = leader;
+            state.hasBest = true;
+        }
+
+        double mean = 0.0;
+        for (const Individual& individual : state.population) mean += individual.fitness;
+        mean /= state.population.size();
+
+        state.totalGames += gamesPerGeneration;
+        runGames += gamesPerGeneration;
+        double runSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+
+        std::printf("gen %3d | %.1f parties/s (moyenne %.1f) | meilleur %.2f | moyenne %.2f | record %.2f\n",
+                    state.generation, gamesPerGeneration / seconds, runGames / runSeconds,
+                    leader.fitness, mean, state.best.fitness);
+        std::printf("        poids [%s]\n", formatWeights(leader.weights).c_str());
+        // La profondeur 1 ne consulte pas la table (seule la racine est cherchée)
+        TranspositionTable::Stats stats = {};
+        if (table) stats = table->getStats();
+        if (stats.probes > 0) {
+            std::printf("        table %.1f %% de succès sur %llu sondages, %.1f %% occupée\n",
+                        stats.hitRate() * 100.0, stats.probes, stats.occupancy() * 100.0);
+            table->resetStats();
+        }
+        std::fflush(stdout);
+
+        state.population = breed(state.population, options, state.rng);
+        state.generation++;
+        if (!saveCheckpoint(options.checkpoint, state)) {
+            std::cout << "Impossible d'écrire le point de reprise " << options.checkpoint << std::endl;
+        }
+    }
+
+    if (state.hasBest) {
+        std::cout << "Meilleurs poids (" << state.best.fitness << " lignes) : "
+                  << formatWeights(state.best.weights) << std::endl;
+    }
+    std::cout << state.totalGames << " parties jouées au total" << std::endl;
+    return 0;
+}
\ No newline at end of file